@@ -55,11 +55,14 @@ namespace RTT {
      *       \a size number of elements can be stored until the reader reads
      *       them. BUFFER drops newer samples on full, CIRCULAR_BUFFER drops older samples on full.
      *       UNBUFFERED is only valid for output streaming connections.
-     *  <li> the locking policy: LOCKED, LOCK_FREE or UNSYNC. This defines how locking is done in the
-     *       connection. For now, only three policies are available. LOCKED uses
+     *  <li> the locking policy: LOCKED, LOCK_FREE, SPSC or UNSYNC. This defines how locking is done in the
+     *       connection. LOCKED uses
      *       mutexes, LOCK_FREE uses a lock free method and UNSYNC means there's no
      *       synchronisation at all (not thread safe). The latter should
      *       be used only when there is no contention (simultaneous write-read).
+     *       SPSC is LOCK_FREE for a connection which is written by a single thread
+     *       and read by a single thread. A BUFFER connection then uses a wait-free
+     *       ring buffer. Other connections and remote connections fall back to LOCK_FREE.
      *
      *  <li> if, upon connection, the last value that has been written on the
      *       writer end should be written on the connection as well to
@@ -100,6 +103,7 @@ namespace RTT {
         static const int UNSYNC    = 0;
         static const int LOCKED    = 1;
         static const int LOCK_FREE = 2;
+        static const int SPSC      = 3;
 
         /**
          * Create a policy for a (lock-free) fifo buffer connection of a given size.
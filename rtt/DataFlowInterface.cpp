@@ -171,9 +171,9 @@ namespace RTT
                     // for this reason, we take a ref to mservice until we leave removePort.
                     mservice_ref = mservice->provides(); // uses shared_from_this()
                     mservice->removeService( name );
-                    if (mservice->getOwner())
-                        mservice->getOwner()->dataOnPortRemoved( *it );
                 }
+                if (mservice && mservice->getOwner())
+                    mservice->getOwner()->dataOnPortRemoved( *it );
                 (*it)->disconnect(); // remove all connections and callbacks.
                 (*it)->setInterface(0);
                 mports.erase(it);
@@ -186,6 +186,8 @@ namespace RTT
               it != mports.end();
               ++it)
             if ( (*it)->getName() == name ) {
+                if (mservice && mservice->getOwner())
+                    mservice->getOwner()->dataOnPortRemoved( *it );
                 (*it)->disconnect(); // remove all connections and callbacks.
                 (*it)->setInterface(0);
                 mports.erase(it);
@@ -46,7 +46,9 @@
 #include "TaskContext.hpp"
 #include "internal/CatchConfig.hpp"
 #include "extras/SlaveActivity.hpp"
+#include "internal/ParallelChildren.hpp"
 
+#include "internal/Completion.hpp"
 #include <boost/bind.hpp>
 #include <algorithm>
 
@@ -69,7 +71,8 @@ namespace RTT
         : taskc(owner),
           mqueue(new MWSRQueue<DisposableInterface*>(ORONUM_EE_MQUEUE_SIZE) ),
           f_queue( new MWSRQueue<ExecutableInterface*>(ORONUM_EE_MQUEUE_SIZE) ),
-          mmaster(0)
+          mfunctions_head(0), mfunctions_tail(0), mfunctions_current(0), mfunctions_count(0),
+          mmaster(0), mparallel(0), mnew_parallel(0), mparallel_update(false), mparallel_workers(0)
     {
     }
 
@@ -77,6 +80,9 @@ namespace RTT
     {
         Logger::In in("~ExecutionEngine");
 
+        delete mparallel;
+        delete mnew_parallel;
+
         // make a copy to avoid call-back troubles:
         std::vector<TaskCore*> copy = children;
         for (std::vector<TaskCore*>::iterator it = copy.begin(); it != copy.end();++it){
@@ -84,9 +90,12 @@ namespace RTT
         }
         assert( children.empty() );
 
-        ExecutableInterface* foo;
-        while ( f_queue->dequeue( foo ) )
+        fetchFunctions();
+        while ( mfunctions_head ) {
+            ExecutableInterface* foo = mfunctions_head;
+            unlinkFunction( foo );
             foo->unloaded();
+        }
 
         DisposableInterface* dis;
         while ( mqueue->dequeue( dis ) )
@@ -110,23 +119,74 @@ namespace RTT
             children.erase(it);
     }
 
-    void ExecutionEngine::processFunctions()
+    void ExecutionEngine::fetchFunctions()
     {
-        // Execute all loaded Functions :
         ExecutableInterface* foo = 0;
-        int nbr = f_queue->size(); // nbr to process.
-        // 1. Fetch new ones from queue.
         while ( f_queue->dequeue(foo) ) {
             assert(foo);
-            if ( foo->execute() == false ){
+            // the running one is appended again after its execution.
+            if ( foo != mfunctions_current )
+                appendFunction( foo );
+        }
+    }
+
+    void ExecutionEngine::appendFunction(ExecutableInterface* f)
+    {
+        if ( f->prev_function || f == mfunctions_head )
+            return; // already running.
+        f->next_function = 0;
+        f->prev_function = mfunctions_tail;
+        if ( mfunctions_tail )
+            mfunctions_tail->next_function = f;
+        else
+            mfunctions_head = f;
+        mfunctions_tail = f;
+        ++mfunctions_count;
+    }
+
+    void ExecutionEngine::unlinkFunction(ExecutableInterface* f)
+    {
+        if ( f->prev_function == 0 && f != mfunctions_head )
+            return; // not running.
+        if ( f->prev_function )
+            f->prev_function->next_function = f->next_function;
+        else
+            mfunctions_head = f->next_function;
+        if ( f->next_function )
+            f->next_function->prev_function = f->prev_function;
+        else
+            mfunctions_tail = f->prev_function;
+        f->next_function = 0;
+        f->prev_function = 0;
+        --mfunctions_count;
+    }
+
+    void ExecutionEngine::processFunctions()
+    {
+        // 1. Fetch new ones from queue.
+        fetchFunctions();
+        // 2. Execute all loaded Functions, each function is unlinked during
+        // its execution, such that a nested processFunctions() (from
+        // waitForFunctions()) does not execute it again.
+        unsigned int nbr = mfunctions_count; // nbr to process.
+        bool done = false;
+        while ( nbr-- != 0 && mfunctions_head ) {
+            ExecutableInterface* foo = mfunctions_head;
+            unlinkFunction( foo );
+            ExecutableInterface* outer = mfunctions_current;
+            mfunctions_current = foo;
+            bool keep = foo->execute();
+            bool removed = mfunctions_current != foo;
+            mfunctions_current = outer;
+            if ( keep == false ){
                 foo->unloaded();
-                msg_cond.broadcast(); // required for waitForFunctions() (3rd party thread)
-            } else {
-                f_queue->enqueue( foo );
+                done = true;
+            } else if ( !removed ) {
+                appendFunction( foo );
             }
-            if ( --nbr == 0) // we did a round-trip
-                break;
         }
+        if ( done )
+            notifyWaiters(); // required for waitForFunctions() (3rd party thread)
     }
 
     bool ExecutionEngine::runFunction( ExecutableInterface* f )
@@ -190,17 +250,12 @@ namespace RTT
         // since this function is executed in process messages, it is always safe to execute.
         if ( !f )
             return false;
-        int nbr = f_queue->size();
-        while (nbr != 0) {
-            ExecutableInterface* foo = 0;
-            if ( !f_queue->dequeue(foo) )
-                return false;
-            if ( f  == foo) {
-                return true;
-            }
-            f_queue->enqueue(foo);
-            --nbr;
-        }
+        // f may still be pending in the queue.
+        fetchFunctions();
+        if ( f == mfunctions_current )
+            mfunctions_current = 0; // removed during its own execution.
+        else
+            unlinkFunction( f );
         return true;
     }
 
@@ -219,21 +274,28 @@ namespace RTT
         // execute all commands from the AtomicQueue.
         // msg_lock may not be held when entering this function !
         DisposableInterface* com(0);
-        {
-            while ( mqueue->dequeue(com) ) {
-                assert( com );
-                com->executeAndDispose();
-            }
-            // there's no need to hold the lock during
-            // emptying the queue. But we must hold the
-            // lock once between excuteAndDispose and the
-            // broadcast to avoid the race condition in
-            // waitForMessages().
-            // This allows us to recurse into processMessages.
-            MutexLock locker( msg_lock );
+        while ( mqueue->dequeue(com) ) {
+            assert( com );
+            com->executeAndDispose();
         }
+        // there's no need to hold the lock during
+        // emptying the queue. This allows us to recurse
+        // into processMessages.
         if ( com )
-            msg_cond.broadcast(); // required for waitForMessages() (3rd party thread)
+            notifyWaiters(); // required for waitForMessages() (3rd party thread)
+    }
+
+    void ExecutionEngine::notifyWaiters()
+    {
+        // Pairs with the increment of mwaiters before a waiter evaluates
+        // its predicate: either the waiter sees our results, or we see it.
+        os::MemoryFence();
+        if ( mwaiters.read() == 0 )
+            return;
+        // We must hold the lock once between executeAndDispose and
+        // the broadcast to avoid the race condition in waitForMessages().
+        MutexLock locker( msg_lock );
+        msg_cond.broadcast();
     }
 
     bool ExecutionEngine::process( DisposableInterface* c )
@@ -250,23 +312,25 @@ namespace RTT
 
             bool result = mqueue->enqueue( c );
             this->getActivity()->trigger();
-            msg_cond.broadcast(); // required for waitAndProcessMessages() (EE thread)
+            os::MemoryFence();
+            if ( mwaiters.read() != 0 )
+                msg_cond.broadcast(); // required for waitAndProcessMessages() (EE thread)
             return result;
         }
         return false;
     }
 
-    void ExecutionEngine::waitForMessages(const boost::function<bool(void)>& pred)
+    void ExecutionEngine::waitForMessages(const boost::function<bool(void)>& pred, Completion* completion)
     {
         // forward the call to the master ExecutionEngine which is processing messages for us...
         if (mmaster) {
-            mmaster->waitForMessages(pred);
+            mmaster->waitForMessages(pred, completion);
             return;
         }
 
         if (this->getActivity()->thread()->isSelf())
             waitAndProcessMessages(pred);
-        else
+        else if ( !completion || !completion->wait() )
             waitForMessagesInternal(pred);
     }
 
@@ -302,9 +366,11 @@ namespace RTT
             return;
         // only to be called from the thread not executing step().
         os::MutexLock lock(msg_lock);
+        mwaiters.inc();
         while (!pred()) { // the mutex guards that processMessages can not run between !pred and the wait().
             msg_cond.wait(msg_lock); // now processMessages may run.
         }
+        mwaiters.dec();
     }
 
 
@@ -317,9 +383,12 @@ namespace RTT
                 // only to be called from the thread executing step().
                 // We must lock because the cond variable will unlock msg_lock.
                 os::MutexLock lock(msg_lock);
+                mwaiters.inc();
                 if (!pred()) {
                     msg_cond.wait(msg_lock); // now processMessages may run.
+                    mwaiters.dec();
                 } else {
+                    mwaiters.dec();
                     return; // do not process messages when pred() == true;
                 }
             }
@@ -335,9 +404,12 @@ namespace RTT
                 // only to be called from the thread executing step().
                 // We must lock because the cond variable will unlock msg_lock.
                 os::MutexLock lock(msg_lock);
+                mwaiters.inc();
                 if (!pred()) {
                     msg_cond.wait(msg_lock); // now processMessages may run.
+                    mwaiters.dec();
                 } else {
+                    mwaiters.dec();
                     return; // do not process messages when pred() == true;
                 }
             }
@@ -355,6 +427,7 @@ namespace RTT
         if ( taskc ) {
             // A trigger() in startHook() will be ignored, we trigger in TaskCore after startHook finishes.
             if ( taskc->mTaskState == TaskCore::Running && taskc->mTargetState == TaskCore::Running ) {
+                taskc->mCycleStatistics.start();
                 TRY (
                     taskc->prepareUpdateHook();
                     taskc->updateHook();
@@ -366,6 +439,7 @@ namespace RTT
                     log(Error) << "in updateHook(): switching to exception state because of unhandled exception" << endlog();
                     taskc->exception(); // calls stopHook,cleanupHook
                 )
+                taskc->mCycleStatistics.stop();
             }
             // in case start() or updateHook() called error(), this will be called:
             if (taskc->mTaskState == TaskCore::RunTimeError && taskc->mTargetState >= TaskCore::Running) {
@@ -383,37 +457,70 @@ namespace RTT
         }
         if ( !this->getActivity() || ! this->getActivity()->isRunning() ) return;
 
+        if ( mparallel_update ) {
+            // the old pool is idle between two steps.
+            MutexLock lock(mparallel_lock);
+            delete mparallel;
+            mparallel = mnew_parallel;
+            mnew_parallel = 0;
+            mparallel_update = false;
+        }
+        if ( mparallel && children.size() > 1 ) {
+            mparallel->run( children );
+            return;
+        }
+
         // call all children as well.
         for (std::vector<TaskCore*>::iterator it = children.begin(); it != children.end();++it) {
-            if ( (*it)->mTaskState == TaskCore::Running  && (*it)->mTargetState == TaskCore::Running  ){
-                TRY (
-                    (*it)->prepareUpdateHook();
-                    (*it)->updateHook();
-                ) CATCH(std::exception const& e,
-                    log(Error) << "in updateHook(): switching to exception state because of unhandled exception" << endlog();
-                    log(Error) << "  " << e.what() << endlog();
-                    (*it)->exception();
-               ) CATCH_ALL (
-                    log(Error) << "in updateHook(): switching to exception state because of unhandled exception" << endlog();
-                    (*it)->exception(); // calls stopHook,cleanupHook
-                )
-            }
-            if ((*it)->mTaskState == TaskCore::RunTimeError && (*it)->mTargetState == TaskCore::RunTimeError){
-                TRY (
-                    (*it)->errorHook();
-                ) CATCH(std::exception const& e,
-                    log(Error) << "in errorHook(): switching to exception state because of unhandled exception" << endlog();
-                    log(Error) << "  " << e.what() << endlog();
-                    (*it)->exception();
-               ) CATCH_ALL (
-                    log(Error) << "in errorHook(): switching to exception state because of unhandled exception" << endlog();
-                    (*it)->exception(); // calls stopHook,cleanupHook
-                )
-            }
+            processChild( *it );
             if ( !this->getActivity() || ! this->getActivity()->isRunning() ) return;
         }
     }
 
+    void ExecutionEngine::processChild(TaskCore* tc) {
+        if ( tc->mTaskState == TaskCore::Running  && tc->mTargetState == TaskCore::Running  ){
+            tc->mCycleStatistics.start();
+            TRY (
+                tc->prepareUpdateHook();
+                tc->updateHook();
+            ) CATCH(std::exception const& e,
+                log(Error) << "in updateHook(): switching to exception state because of unhandled exception" << endlog();
+                log(Error) << "  " << e.what() << endlog();
+                tc->exception();
+           ) CATCH_ALL (
+                log(Error) << "in updateHook(): switching to exception state because of unhandled exception" << endlog();
+                tc->exception(); // calls stopHook,cleanupHook
+            )
+            tc->mCycleStatistics.stop();
+        }
+        if (tc->mTaskState == TaskCore::RunTimeError && tc->mTargetState == TaskCore::RunTimeError){
+            TRY (
+                tc->errorHook();
+            ) CATCH(std::exception const& e,
+                log(Error) << "in errorHook(): switching to exception state because of unhandled exception" << endlog();
+                log(Error) << "  " << e.what() << endlog();
+                tc->exception();
+           ) CATCH_ALL (
+                log(Error) << "in errorHook(): switching to exception state because of unhandled exception" << endlog();
+                tc->exception(); // calls stopHook,cleanupHook
+            )
+        }
+    }
+
+    void ExecutionEngine::setParallelChildren(unsigned int workers, int scheduler, int priority, unsigned cpu_affinity) {
+        ParallelChildren* p = workers ? new ParallelChildren(this, workers, scheduler, priority, cpu_affinity) : 0;
+        MutexLock lock(mparallel_lock);
+        // replaces a pool which was not taken by processChildren() yet.
+        delete mnew_parallel;
+        mnew_parallel = p;
+        mparallel_workers = workers;
+        mparallel_update = true;
+    }
+
+    unsigned int ExecutionEngine::getParallelChildren() const {
+        return mparallel_workers;
+    }
+
     bool ExecutionEngine::breakLoop() {
         bool ok = true;
         if (taskc)
@@ -42,6 +42,8 @@
 #include "os/Mutex.hpp"
 #include "os/MutexLock.hpp"
 #include "os/Condition.hpp"
+#include "os/Atomic.hpp"
+#include "os/threads.hpp"
 #include "base/RunnableInterface.hpp"
 #include "base/ActivityInterface.hpp"
 #include "base/DisposableInterface.hpp"
@@ -124,10 +126,11 @@ namespace RTT
         /**
          * Run a given function in step() or loop(). The function may only
          * be destroyed after the
-         * ExecutionEngine is stopped or removeFunction() was invoked. The number of functions the Processor can
-         * run in parallel can be increased with setMaxFunctions().
+         * ExecutionEngine is stopped or removeFunction() was invoked. There is no limit on
+         * the number of running functions, but at most ORONUM_EE_MQUEUE_SIZE functions
+         * can be pending to be picked up by the next step.
          * @return false if the Engine is not running or the 'pending' queue is full.
-         * @see removeFunction(), setMaxFunctions()
+         * @see removeFunction()
          */
         virtual bool runFunction(base::ExecutableInterface* f);
 
@@ -151,10 +154,13 @@ namespace RTT
          * when pred() returns true.
          * @param pred As long as !pred() blocks the calling thread. If pred() == true
          * when entering this function, returns immediately.
+         * @param completion If not null, a thread other than the thread of this
+         * engine only waits until \a completion is completed, instead of being
+         * woken up each time messages are processed.
          *
          * This function is for internal use only and is required for asynchronous method invocations.
          */
-        void waitForMessages(const boost::function<bool(void)>& pred);
+        void waitForMessages(const boost::function<bool(void)>& pred, internal::Completion* completion = 0);
 
         /**
          * Call this if you wish to block on a function completing in the Execution Engine.
@@ -199,6 +205,31 @@ namespace RTT
          */
         virtual void setActivity( base::ActivityInterface* task );
 
+        /**
+         * Execute the updateHook() of the children of this engine in
+         * parallel, on a pool of worker threads owned by this engine.
+         * Each step hands the children to the pool and returns when
+         * all of them returned. The thread of this engine executes
+         * one child itself. The new setting takes effect at the next
+         * step.
+         *
+         * @note A child executed by a worker must not wait for an
+         * operation that is executed by the thread of this engine,
+         * since that thread is waiting for the child.
+         * @param workers The number of worker threads, 0 to execute
+         * the children one after the other in the thread of this engine.
+         * @param scheduler The scheduler of the worker threads.
+         * @param priority The priority of the worker threads.
+         * @param cpu_affinity The cpu mask of the worker threads.
+         */
+        void setParallelChildren(unsigned int workers, int scheduler = ORO_SCHED_OTHER,
+                                 int priority = os::LowestPriority, unsigned cpu_affinity = ~0);
+
+        /**
+         * Returns the number of worker threads set with setParallelChildren().
+         */
+        unsigned int getParallelChildren() const;
+
     protected:
         /**
          * Call this if you wish to block on a message arriving in the Execution Engine.
@@ -256,23 +287,78 @@ namespace RTT
         std::vector<base::TaskCore*> children;
 
         /**
-         * Stores all functions we're executing.
+         * Hands over functions loaded with runFunction() to the
+         * thread of this engine.
          */
         internal::MWSRQueue<base::ExecutableInterface*>* f_queue;
 
+        /**
+         * Intrusive list of all functions we're executing. Only used
+         * by the thread of this engine.
+         */
+        base::ExecutableInterface* mfunctions_head;
+        base::ExecutableInterface* mfunctions_tail;
+
+        /**
+         * The function being executed by processFunctions(), it is
+         * cleared when that function is removed during its execution.
+         */
+        base::ExecutableInterface* mfunctions_current;
+        unsigned int mfunctions_count;
+
         os::Mutex msg_lock;
         os::Condition msg_cond;
 
+        /**
+         * The number of threads waiting on msg_cond. msg_cond is only
+         * locked and broadcast when it is not zero.
+         */
+        os::AtomicInt mwaiters;
+
         /**
          * A master ExecutionEngine which should process our messages.
          * This is used for ExecutionEngines running in a SlaveActivity which forward incoming messages to their master engine.
          */
         ExecutionEngine *mmaster;
 
+        /**
+         * Executes the children in parallel, if not null. Only
+         * used by the thread of this engine.
+         */
+        internal::ParallelChildren* mparallel;
+        /**
+         * The next value of mparallel, set by setParallelChildren().
+         * Guarded by mparallel_lock.
+         */
+        internal::ParallelChildren* mnew_parallel;
+        volatile bool mparallel_update;
+        unsigned int mparallel_workers;
+        os::Mutex mparallel_lock;
+        friend class internal::ParallelChildren;
+
         void processMessages();
         void processFunctions();
+
+        /**
+         * Wakes up the threads waiting on msg_cond, if any.
+         */
+        void notifyWaiters();
+
+        /**
+         * Moves the functions loaded with runFunction() from f_queue
+         * to the list of running functions.
+         */
+        void fetchFunctions();
+
+        void appendFunction(base::ExecutableInterface* f);
+        void unlinkFunction(base::ExecutableInterface* f);
         void processChildren();
 
+        /**
+         * Executes the updateHook() or errorHook() of one child.
+         */
+        void processChild(base::TaskCore* tc);
+
         virtual bool initialize();
 
         /**
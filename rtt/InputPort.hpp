@@ -84,6 +84,77 @@ namespace RTT
             return false;
         }
 
+        bool do_read_newest(typename base::ChannelElement<T>::reference_t sample, FlowStatus& result, bool copy_old_data, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            typename base::ChannelElement<T>::shared_ptr input = static_cast< base::ChannelElement<T>* >( descriptor.get<1>().get() );
+            assert( result != NewData );
+            if ( input ) {
+                FlowStatus tresult = input->readNewest(sample, copy_old_data);
+                if (tresult == NewData) {
+                    result = tresult;
+                    return true;
+                }
+                if (tresult > result)
+                    result = tresult;
+            }
+            return false;
+        }
+
+        bool do_read_all(std::vector<T>& samples, FlowStatus& result, bool copy_old_data, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            typename base::ChannelElement<T>::shared_ptr input = static_cast< base::ChannelElement<T>* >( descriptor.get<1>().get() );
+            if ( input ) {
+                FlowStatus tresult = input->readBatch(samples);
+                if (tresult > result)
+                    result = tresult;
+            }
+            // visit all connections.
+            return false;
+        }
+
+        bool do_read_shared(typename base::ChannelElement<T>::sample_ptr& sample, FlowStatus& result, bool copy_old_data, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            typename base::ChannelElement<T>::shared_ptr input = static_cast< base::ChannelElement<T>* >( descriptor.get<1>().get() );
+            assert( result != NewData );
+            if ( input ) {
+                FlowStatus tresult = input->readShared(sample, copy_old_data);
+                if (tresult == NewData) {
+                    result = tresult;
+                    return true;
+                }
+                if (tresult > result)
+                    result = tresult;
+            }
+            return false;
+        }
+
+        bool do_read_loan(typename base::ChannelElement<T>::sample_ptr& sample, FlowStatus& result, bool copy_old_data, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            typename base::ChannelElement<T>::shared_ptr input = static_cast< base::ChannelElement<T>* >( descriptor.get<1>().get() );
+            assert( result != NewData );
+            if ( input ) {
+                FlowStatus tresult = input->readShared(sample, copy_old_data);
+                if (tresult == NoData) {
+                    // this connection does not store shared samples: copy
+                    // into a sample of our own pool.
+                    internal::LoanedSample<T> copy = loan_pool->loan();
+                    tresult = input->read(*copy, copy_old_data);
+                    if ( tresult == NewData || (tresult == OldData && copy_old_data) )
+                        sample = copy.release();
+                }
+                if (tresult == NewData) {
+                    result = tresult;
+                    return true;
+                }
+                if (tresult > result)
+                    result = tresult;
+            }
+            return false;
+        }
+
+        /// The samples handed out by readLoan() for connections that do not store shared samples.
+        typename internal::SharedSamplePool<T>::shared_ptr loan_pool;
+
         /**
          * You are not allowed to copy ports.
          * In case you want to create a container of ports,
@@ -93,6 +164,10 @@ namespace RTT
         InputPort(InputPort const& orig);
         InputPort& operator=(InputPort const& orig);
     public:
+        /** A read-only, reference counted view on a sample written by an
+         * OutputPort in shared sample mode. */
+        typedef typename base::ChannelElement<T>::sample_ptr sample_ptr;
+
         InputPort(std::string const& name = "unnamed", ConnPolicy const& default_policy = ConnPolicy())
             : base::InputPortInterface(name, default_policy)
         {}
@@ -157,6 +232,47 @@ namespace RTT
         }
 
 
+        /** Reads a shared sample from the connection, without copying its
+         * data. \a sample is updated to refer to the sample written by the
+         * OutputPort, which remains valid for as long as \a sample refers to it.
+         *
+         * Only connections created by an OutputPort in shared sample mode
+         * store shared samples. Other connections return RTT::NoData, use
+         * read() on these.
+         * @see OutputPort::shareSamples()
+         */
+        FlowStatus readShared(sample_ptr& sample, bool copy_old_data = true)
+        {
+            FlowStatus result = NoData;
+            cmanager.select_reader_channel( boost::bind( &InputPort::do_read_shared, this, boost::ref(sample), boost::ref(result), _1, _2 ), copy_old_data );
+            return result;
+        }
+
+        /** Reads a sample from the connection and returns a read-only handle
+         * to it in \a sample, which keeps the sample alive until it is reset or
+         * goes out of scope. On connections of an OutputPort in shared
+         * sample mode, this is the written sample itself and no data is copied.
+         * On other connections, the data is copied once into a sample of
+         * a pool owned by this port.
+         *
+         * The FlowStatus and \a copy_old_data have the same meaning as for read().
+         * @see OutputPort::loan()
+         * @nrt on the first call, which creates the pool of this port.
+         */
+        FlowStatus readLoan(sample_ptr& sample, bool copy_old_data = true)
+        {
+            if (!loan_pool) {
+                T sample_data = T();
+                getDataSample(sample_data);
+                loan_pool.reset( new internal::SharedSamplePool<T>(sample_data) );
+                // the sample held by the caller and the one being read.
+                loan_pool->reserve( 2 );
+            }
+            FlowStatus result = NoData;
+            cmanager.select_reader_channel( boost::bind( &InputPort::do_read_loan, this, boost::ref(sample), boost::ref(result), _1, _2 ), copy_old_data );
+            return result;
+        }
+
         /** Read all new samples that are available on this port, and returns
          * the last one.
          *
@@ -165,14 +281,36 @@ namespace RTT
          */
         FlowStatus readNewest(typename base::ChannelElement<T>::reference_t sample, bool copy_old_data = true)
         {
-            FlowStatus result = read(sample, copy_old_data);
+            FlowStatus result = NoData;
+            // each connection is drained at once, without copying its older samples.
+            cmanager.select_reader_channel( boost::bind( &InputPort::do_read_newest, this, boost::ref(sample), boost::ref(result), _1, _2 ), copy_old_data );
             if (result != RTT::NewData)
                 return result;
 
-            while (read(sample, false) == RTT::NewData);
+            // other connections may have new data as well.
+            do {
+                result = NoData;
+                cmanager.select_reader_channel( boost::bind( &InputPort::do_read_newest, this, boost::ref(sample), boost::ref(result), _1, _2 ), false );
+            } while (result == RTT::NewData);
             return RTT::NewData;
         }
 
+        /** Reads all new samples that are available on this port into
+         * \a samples, replacing its contents. Each connection is drained
+         * at once, its samples are stored oldest first.
+         *
+         * Returns RTT::NewData if at least one new sample was available, and
+         * either RTT::OldData or RTT::NoData otherwise. Old data is never
+         * stored in \a samples.
+         */
+        FlowStatus readAll(std::vector<T>& samples)
+        {
+            FlowStatus result = NoData;
+            samples.clear();
+            cmanager.select_reader_channel( boost::bind( &InputPort::do_read_all, this, boost::ref(samples), boost::ref(result), _1, _2 ), false );
+            return result;
+        }
+
         /**
          * Get a sample of the data on this port, without actually reading the port's data.
          * It's the complement of OutputPort::setDataSample() and serves to retrieve the size
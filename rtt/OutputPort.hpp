@@ -84,6 +84,32 @@ namespace RTT
             }
         }
 
+        bool do_write_shared(typename base::ChannelElement<T>::sample_ptr const& sample, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            typename base::ChannelElement<T>::shared_ptr output
+                = boost::static_pointer_cast< base::ChannelElement<T> >(descriptor.get<1>());
+            if (output->writeShared(sample))
+                return false;
+            else
+            {
+                log(Error) << "A channel of port " << getName() << " has been invalidated during write(), it will be removed" << endlog();
+                return true;
+            }
+        }
+
+        bool do_write_batch(std::vector<T> const& samples, const internal::ConnectionManager::ChannelDescriptor& descriptor)
+        {
+            typename base::ChannelElement<T>::shared_ptr output
+                = boost::static_pointer_cast< base::ChannelElement<T> >(descriptor.get<1>());
+            if (output->writeBatch(samples))
+                return false;
+            else
+            {
+                log(Error) << "A channel of port " << getName() << " has been invalidated during write(), it will be removed" << endlog();
+                return true;
+            }
+        }
+
         bool do_init(typename base::ChannelElement<T>::param_t sample, const internal::ConnectionManager::ChannelDescriptor& descriptor)
         {
             typename base::ChannelElement<T>::shared_ptr output
@@ -105,6 +131,10 @@ namespace RTT
             typename base::ChannelElement<T>::shared_ptr channel_el_input =
                 static_cast< base::ChannelElement<T>* >(channel_input.get());
 
+            // Make room in the pool for the samples this connection can hold.
+            if (shared_pool)
+                shared_pool->reserve( internal::ConnFactory::sharedSampleCapacity(policy) );
+
             if (has_initial_sample)
             {
                 T const& initial_sample = sample->Get();
@@ -135,6 +165,8 @@ namespace RTT
         // This is used to allow the use of the 'init' connection policy option
         bool keeps_last_written_value;
         typename base::DataObjectInterface<T>::shared_ptr sample;
+        /// Non-null if this port is in shared sample mode.
+        typename internal::SharedSamplePool<T>::shared_ptr shared_pool;
 
         /**
          * You are not allowed to copy ports.
@@ -186,6 +218,49 @@ namespace RTT
 
         bool keepsLastWrittenValue() const { return keeps_last_written_value; }
 
+        /**
+         * Turns shared sample mode on or off. In shared sample mode, write()
+         * copies each sample once into a reference counted, immutable sample
+         * taken from a preallocated pool, and all local connections store a
+         * reference to that sample instead of a copy. Readers can obtain a
+         * read-only view on it with InputPort::readShared(), or a copy with
+         * InputPort::read().
+         *
+         * The pool grows when connections are created, and is initialized
+         * with the sample given to setDataSample(). Only connections created
+         * after this call store shared samples, so call it before connecting
+         * this port.
+         * @nts
+         * @nrt
+         */
+        void shareSamples(bool share)
+        {
+            if ( share == sharesSamples() )
+                return;
+            T last = sample->Get();
+            if (share) {
+                shared_pool.reset( new internal::SharedSamplePool<T>(last) );
+                // the last written value and the sample being written.
+                shared_pool->reserve( 4 + 1 );
+                sample.reset( new internal::SharedDataObject<T>(shared_pool, last) );
+            } else {
+                sample.reset( new base::DataObject<T>(last) );
+                shared_pool.reset();
+            }
+        }
+
+        /**
+         * Returns true if this port is in shared sample mode.
+         * @see shareSamples()
+         */
+        bool sharesSamples() const { return shared_pool.get() != 0; }
+
+        /**
+         * Returns the pool of shared samples of this port, or null if it
+         * is not in shared sample mode.
+         */
+        typename internal::SharedSamplePool<T>::shared_ptr getSharedSamplePool() const { return shared_pool; }
+
         /**
          * Returns the last written value written to this port, in case it is
          * kept by this port, otherwise, returns a default T().
@@ -230,6 +305,9 @@ namespace RTT
         void setDataSample(const T& sample)
         {
             this->sample->Set(sample);
+            // after Set(), such that the sample it replaced is initialized too.
+            if (shared_pool)
+                shared_pool->data_sample(sample);
             has_initial_sample = true;
             has_last_written_value = false;
 
@@ -244,6 +322,11 @@ namespace RTT
          */
         void write(const T& sample)
         {
+            if (shared_pool) {
+                writeShared( shared_pool->allocate(sample) );
+                return;
+            }
+
             if (keeps_last_written_value || keeps_next_written_value)
             {
                 keeps_next_written_value = false;
@@ -257,6 +340,91 @@ namespace RTT
                     );
         }
 
+        /**
+         * Writes a batch of samples to all receivers (if any), oldest
+         * first. Buffered connections store the whole batch at once and
+         * wake up their reader only once, data connections only keep
+         * the last sample of the batch.
+         * @param samples The new samples to send out.
+         */
+        void write(const std::vector<T>& samples)
+        {
+            if (samples.empty())
+                return;
+
+            if (shared_pool) {
+                typename std::vector<T>::const_iterator it;
+                for (it = samples.begin(); it != samples.end(); ++it)
+                    writeShared( shared_pool->allocate(*it) );
+                return;
+            }
+
+            if (keeps_last_written_value || keeps_next_written_value)
+            {
+                keeps_next_written_value = false;
+                has_initial_sample = true;
+                this->sample->Set(samples.back());
+            }
+            has_last_written_value = keeps_last_written_value;
+
+            cmanager.delete_if( boost::bind(
+                        &OutputPort<T>::do_write_batch, this, boost::cref(samples), _1 )
+                    );
+        }
+
+        /**
+         * Lends out a sample of this port's pool, such that it can be
+         * filled in place and be published with commit() without copying
+         * it. The loaned sample holds the data of an earlier written sample or
+         * the data sample, so all of it must be overwritten.
+         *
+         * Only ports in shared sample mode can lend out samples. Other ports
+         * return an empty loan.
+         * @see shareSamples()
+         * @rt if the pool has a free sample, otherwise a heap allocation is done.
+         */
+        internal::LoanedSample<T> loan()
+        {
+            if (!shared_pool)
+                return internal::LoanedSample<T>();
+            return shared_pool->loan();
+        }
+
+        /**
+         * Publishes a sample obtained with loan() to all receivers,
+         * as write() would do. The sample is not copied.
+         * @post !sample.valid()
+         * @return false if \a sample was empty.
+         */
+        bool commit(internal::LoanedSample<T>& sample)
+        {
+            if ( !sample.valid() )
+                return false;
+            writeShared( sample.release() );
+            return true;
+        }
+
+    private:
+        /**
+         * Writes \a sample in shared sample mode: all connections
+         * are handed out a reference to it.
+         */
+        void writeShared(typename base::ChannelElement<T>::sample_ptr const& shared)
+        {
+            if (keeps_last_written_value || keeps_next_written_value)
+            {
+                keeps_next_written_value = false;
+                has_initial_sample = true;
+                static_cast< internal::SharedDataObject<T>* >(this->sample.get())->SetShared(shared);
+            }
+            has_last_written_value = keeps_last_written_value;
+
+            cmanager.delete_if( boost::bind(
+                        &OutputPort<T>::do_write_shared, this, boost::cref(shared), _1 )
+                    );
+        }
+
+    public:
         void write(base::DataSourceBase::shared_ptr source)
         {
             typename internal::AssignableDataSource<T>::shared_ptr ds =
@@ -49,7 +49,10 @@
 
 #include "internal/DataSource.hpp"
 #include "internal/mystd.hpp"
-#include "internal/MWSRQueue.hpp"
+#include "internal/PortEventSet.hpp"
+#include "internal/TriggerCoalescer.hpp"
+#include "internal/CycleStatisticsService.hpp"
+#include "os/threads.hpp"
 #include "OperationCaller.hpp"
 
 #include "rtt-config.h"
@@ -69,7 +72,7 @@ namespace RTT
 
     TaskContext::TaskContext(const std::string& name, TaskState initial_state /*= Stopped*/)
         :  TaskCore( initial_state)
-           ,portqueue( new MWSRQueue<PortInterface*>(64) )
+           ,portevents( new PortEventSet() ), mcoalescer(0)
            ,tcservice(new Service(name,this) ), tcrequests( new ServiceRequester(name,this) )
 #if defined(ORO_ACT_DEFAULT_SEQUENTIAL)
            ,our_act( new SequentialActivity( this->engine() ) )
@@ -82,7 +85,7 @@ namespace RTT
 
     TaskContext::TaskContext(const std::string& name, ExecutionEngine* parent, TaskState initial_state /*= Stopped*/ )
         :  TaskCore(parent, initial_state)
-           ,portqueue( new MWSRQueue<PortInterface*>(64) )
+           ,portevents( new PortEventSet() ), mcoalescer(0)
            ,tcservice(new Service(name,this) ), tcrequests( new ServiceRequester(name,this) )
 #if defined(ORO_ACT_DEFAULT_SEQUENTIAL)
            ,our_act( parent ? 0 : new SequentialActivity( this->engine() ) )
@@ -118,7 +121,11 @@ namespace RTT
         this->addOperation("update", &TaskContext::update, this, ClientThread).doc("Execute (call) the update method directly.\n Only succeeds if the task isRunning() and allowed by the Activity executing this task.");
 
         this->addOperation("trigger", &TaskContext::trigger, this, ClientThread).doc("Trigger the update method for execution in the thread of this task.\n Only succeeds if the task isRunning() and allowed by the Activity executing this task.");
+        this->addOperation("setTriggerCoalescing", &TaskContext::setTriggerCoalescing, this, ClientThread).doc("Trigger this TaskContext at most once per interval for new data on event ports. Fails if running.").arg("min_interval", "Minimum time between two triggers in seconds, 0.0 to disable.").arg("max_samples", "Trigger anyway after this number of samples, 0 for no limit.");
+        this->addOperation("getSuppressedTriggerCount", &TaskContext::getSuppressedTriggerCount, this, ClientThread).doc("Get the number of event port samples whose trigger was merged with another one.");
         this->addOperation("loadService", &TaskContext::loadService, this, ClientThread).doc("Loads a service known to RTT into this component.").arg("service_name","The name with which the service is registered by in the PluginLoader.");
+        this->getCycleStatistics().setName( this->getName() );
+        provides()->addService( Service::shared_ptr( new CycleStatisticsService(this) ) );
         // activity runs from the start.
         if (our_act)
             our_act->start();
@@ -149,7 +156,8 @@ namespace RTT
             }
             // Do not call this->disconnect() !!!
             // Ports are probably already destructed by user code.
-            delete portqueue;
+            delete mcoalescer;
+            delete portevents;
         }
 
     bool TaskContext::connectPorts( TaskContext* peer )
@@ -427,38 +435,59 @@ namespace RTT
     void TaskContext::dataOnPort(PortInterface* port)
     {
         if ( this->dataOnPortHook(port) ) {
-            portqueue->enqueue( port );
-            this->getActivity()->trigger();
+            portevents->push( port );
+            if (mcoalescer)
+                mcoalescer->trigger();
+            else
+                this->getActivity()->trigger();
         }
     }
 
+    bool TaskContext::setTriggerCoalescing(Seconds min_interval, unsigned int max_samples)
+    {
+        if ( this->isRunning() || min_interval < 0.0 )
+            return false;
+        delete mcoalescer;
+        mcoalescer = 0;
+        if ( min_interval == 0.0 )
+            return true;
+        // the catch-up trigger runs at the priority of our own thread.
+        int scheduler = ORO_SCHED_OTHER;
+        int priority = os::LowestPriority;
+        if ( this->getActivity() && this->getActivity()->thread() ) {
+            scheduler = this->getActivity()->thread()->getScheduler();
+            priority = this->getActivity()->thread()->getPriority();
+        }
+        mcoalescer = new TriggerCoalescer(this, min_interval, max_samples, scheduler, priority);
+        return true;
+    }
+
+    unsigned int TaskContext::getPortTriggerCount() const
+    {
+        return mcoalescer ? mcoalescer->getTriggerCount() : 0;
+    }
+
+    unsigned int TaskContext::getSuppressedTriggerCount() const
+    {
+        return mcoalescer ? mcoalescer->getSuppressedCount() : 0;
+    }
+
     bool TaskContext::dataOnPortHook( base::PortInterface* ) {
         return this->isRunning();
     }
 
     void TaskContext::dataOnPortCallback(InputPortInterface* port, TaskContext::SlotFunction callback) {
-        // user_callbacks will only be emitted from updateHook().
-        MutexLock lock(mportlock);
-        user_callbacks[port] = callback;
+        // callbacks will only be emitted from updateHook().
+        portevents->setCallback(port, callback);
     }
 
     void TaskContext::dataOnPortRemoved(PortInterface* port) {
-        MutexLock lock(mportlock);
-        UserCallbacks::iterator it = user_callbacks.find(port);
-        if (it != user_callbacks.end() ) {
-            user_callbacks.erase(it);
-        }
+        portevents->removeCallback(port);
     }
 
     void TaskContext::prepareUpdateHook()
     {
-        MutexLock lock(mportlock);
-        PortInterface* port = 0;
-        while ( portqueue->dequeue( port ) == true ) {
-            UserCallbacks::iterator it = user_callbacks.find(port);
-            if (it != user_callbacks.end() )
-                it->second(port); // fire the user callback
-        }
+        portevents->process();
     }
 }
 
@@ -46,6 +46,7 @@
 #include "DataFlowInterface.hpp"
 #include "ExecutionEngine.hpp"
 #include "base/TaskCore.hpp"
+#include "internal/rtt-internal-fwd.hpp"
 #include <boost/make_shared.hpp>
 
 #include <string>
@@ -561,6 +562,34 @@ namespace RTT
             return ports()->addEventPort(port,callback);
         }
 
+        /**
+         * Merges the triggers that new data on event ports causes, such
+         * that the activity of this component is triggered at most once
+         * per \a min_interval. A sample that arrives within the interval
+         * is processed at the latest when the interval ends. Use this for
+         * high-rate event ports, where triggering per sample would cost
+         * more than the processing itself.
+         * @param min_interval The minimum time between two triggers, in seconds.
+         * A value of zero disables coalescing, which is the default.
+         * @param max_samples Trigger anyway as soon as this number of samples
+         * is pending. Zero means no limit.
+         * @return false if this->isRunning() or if \a min_interval is negative.
+         */
+        bool setTriggerCoalescing(Seconds min_interval, unsigned int max_samples = 0);
+
+        /**
+         * Returns the number of times event ports triggered this component
+         * since trigger coalescing was enabled. Returns zero if it is disabled.
+         */
+        unsigned int getPortTriggerCount() const;
+
+        /**
+         * Returns the number of samples on event ports that did not trigger
+         * this component because their trigger was merged with another one.
+         * Returns zero if trigger coalescing is disabled.
+         */
+        unsigned int getSuppressedTriggerCount() const;
+
         /**
          * Get a port of this Component.
          * @param name The port name
@@ -643,9 +672,11 @@ namespace RTT
         void setup();
 
         friend class DataFlowInterface;
-        internal::MWSRQueue<base::PortInterface*>* portqueue;
-        typedef std::map<base::PortInterface*, SlotFunction > UserCallbacks;
-        UserCallbacks user_callbacks;
+        /**
+         * The event ports with a callback that received new data.
+         */
+        internal::PortEventSet* portevents;
+        internal::TriggerCoalescer* mcoalescer;
 
         /**
          * This callback is called each time data arrived on an
@@ -687,7 +718,6 @@ namespace RTT
 
         Service::shared_ptr tcservice;
         ServiceRequester::shared_ptr tcrequests;
-        os::Mutex mportlock;
 
         // non copyable
         TaskContext( TaskContext& );
@@ -53,6 +53,7 @@
 #else
 #include "BufferLocked.hpp"
 #include "BufferLockFree.hpp"
+#include "BufferSPSC.hpp"
 #endif
 
 namespace RTT
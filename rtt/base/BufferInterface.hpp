@@ -97,6 +97,17 @@ namespace RTT
 	 **/
 	virtual value_t* PopWithoutRelease() = 0;
 
+	/**
+	 * Drops all but the newest element of the buffer, and
+	 * returns a pointer to that element. The dropped elements
+	 * are not copied.
+	 *
+	 * Note the pointer needs the be released by calling Release
+	 * on the buffer.
+	 *
+	 * @return a pointer to a sample or Zero if buffer is empty
+	 **/
+	virtual value_t* PopNewestWithoutRelease() = 0;
 	/**
 	 *  Releases the pointer
 	 * @param item pointer aquired using PopWithoutRelease()
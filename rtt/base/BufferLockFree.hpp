@@ -203,15 +203,37 @@ namespace RTT
 
         size_type Push(const std::vector<T>& items)
         {
-            // @todo Make this function more efficient as in BufferLocked.
-            int towrite  = items.size();
+            size_type towrite = items.size();
             size_type written = 0;
-            typename std::vector<T>::const_iterator it;
-            for(  it = items.begin(); it != items.end(); ++it) {
-                if ( this->Push( *it ) == false ) {
-                    break; // will only happen in non-circular case !
+            if (mcircular) {
+                // Push() accounts for the samples it overwrites or drops.
+                typename std::vector<T>::const_iterator it;
+                for(  it = items.begin(); it != items.end(); ++it)
+                    if ( this->Push( *it ) )
+                        written++;
+                return written;
+            }
+            // Copy the items into the pool and queue them in chunks, such
+            // that the queue's write index is claimed once per chunk.
+            const size_type chunk_size = 32;
+            Item* chunk[chunk_size];
+            while ( written != towrite ) {
+                size_type n = towrite - written;
+                if (n > chunk_size)
+                    n = chunk_size;
+                if (n > capacity() - size())
+                    n = capacity() - size();
+                size_type allocated = 0;
+                while ( allocated != n && (chunk[allocated] = mpool.allocate()) != 0 ) {
+                    *chunk[allocated] = items[written + allocated];
+                    ++allocated;
                 }
-                written++;
+                size_type queued = bufs.enqueue( chunk, allocated );
+                for (size_type i = queued; i != allocated; ++i)
+                    mpool.deallocate( chunk[i] );
+                written += queued;
+                if ( queued == 0 )
+                    break;
             }
             droppedSamples.add(towrite - written);
             return written;
@@ -249,6 +271,18 @@ namespace RTT
 	    return ipop;
 	}
 
+        value_t* PopNewestWithoutRelease()
+        {
+            Item* ipop;
+            Item* newest = 0;
+            while ( bufs.dequeue( ipop ) ) {
+                if ( newest && mpool.deallocate( newest ) == false )
+                    assert(false);
+                newest = ipop;
+            }
+            return newest;
+        }
+
 	void Release(value_t *item) 
 	{
             if (mpool.deallocate( item ) == false )
@@ -0,0 +1,261 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  BufferSPSC.hpp
+
+                        BufferSPSC.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_BUFFER_SPSC_HPP
+#define ORO_BUFFER_SPSC_HPP
+
+#include "../os/Atomic.hpp"
+#include "../os/CAS.hpp"
+#include "BufferInterface.hpp"
+#include <vector>
+#include <algorithm>
+
+namespace RTT
+{ namespace base {
+
+    /**
+     * A wait-free ring buffer for exactly one writing and one reading
+     * thread, to read and write data of type \a T in a FIFO way.
+     *
+     * The samples are stored in place, in a ring of \a bufsize + 2
+     * slots. The writer only modifies the head index and the reader
+     * only modifies the tail index, each on its own cache line, so
+     * Push() and Pop() never loop nor allocate memory.
+     *
+     * The slot of the last popped sample is never overwritten before
+     * the next pop, such that PopWithoutRelease() does not need to copy.
+     * Hence the reader may hold at most one popped sample: any Pop*()
+     * invalidates the sample returned by the previous Pop*WithoutRelease(),
+     * and Release() is a no-op. A circular BufferSPSC can not exist,
+     * since only the reader may drop old samples.
+     * @param T The value type to be stored in the Buffer.
+     * @ingroup PortBuffers
+     */
+    template< class T>
+    class BufferSPSC
+        : public BufferInterface<T>
+    {
+    public:
+        typedef typename BufferInterface<T>::reference_t reference_t;
+        typedef typename BufferInterface<T>::param_t param_t;
+        typedef typename BufferInterface<T>::size_type size_type;
+        typedef T value_t;
+
+        /**
+         * The size of a cache line, used to separate the indices.
+         */
+        enum { CACHE_LINE_SIZE = 64 };
+    private:
+        typedef T Item;
+        const unsigned int mslots;
+        Item* mitems;
+        RTT::os::AtomicInt droppedSamples;
+
+        char pad_front[CACHE_LINE_SIZE];
+        /**
+         * The next slot to write. Only modified by the writer.
+         */
+        volatile unsigned int mhead;
+        char pad_middle[CACHE_LINE_SIZE];
+        /**
+         * The next slot to read. Only modified by the reader.
+         */
+        volatile unsigned int mtail;
+        char pad_back[CACHE_LINE_SIZE];
+
+        unsigned int next(unsigned int i) const
+        {
+            return i + 1 == mslots ? 0 : i + 1;
+        }
+
+        /**
+         * The number of slots the writer may fill, seen from the writer.
+         */
+        size_type space(unsigned int head) const
+        {
+            unsigned int tail = mtail;
+            // one slot separates head from tail, one holds the last popped sample.
+            return (tail + mslots - head - 2) % mslots;
+        }
+
+        // non-copyable !
+        BufferSPSC(const BufferSPSC<T>&);
+
+    public:
+        /**
+         * Create a single producer, single consumer buffer wich can store
+         * \a bufsize elements.
+         * @param bufsize the capacity of the buffer.
+         */
+        BufferSPSC( unsigned int bufsize, const T& initial_value = T() )
+            : mslots( bufsize + 2 ), mitems( new Item[bufsize + 2] ), droppedSamples(0),
+              mhead(0), mtail(0)
+        {
+            data_sample( initial_value );
+        }
+
+        ~BufferSPSC() {
+            delete[] mitems;
+        }
+
+        virtual void data_sample( const T& sample )
+        {
+            for ( unsigned int i = 0; i != mslots; ++i )
+                mitems[i] = sample;
+        }
+
+        virtual T data_sample() const
+        {
+            return mitems[0];
+        }
+
+        size_type capacity() const
+        {
+            return mslots - 2;
+        }
+
+        size_type size() const
+        {
+            return (mhead + mslots - mtail) % mslots;
+        }
+
+        bool empty() const
+        {
+            return mhead == mtail;
+        }
+
+        bool full() const
+        {
+            return space(mhead) == 0;
+        }
+
+        /**
+         * Drops all samples. May only be called by the reader.
+         */
+        void clear()
+        {
+            os::MemoryFence();
+            mtail = mhead;
+        }
+
+        virtual size_type dropped() const
+        {
+            return droppedSamples.read();
+        }
+
+        bool Push( param_t item)
+        {
+            unsigned int head = mhead;
+            if ( space(head) == 0 ) {
+                droppedSamples.inc();
+                return false;
+            }
+            mitems[head] = item;
+            // publish the sample before the index.
+            os::MemoryFence();
+            mhead = next(head);
+            return true;
+        }
+
+        size_type Push(const std::vector<T>& items)
+        {
+            unsigned int head = mhead;
+            size_type towrite = std::min( size_type(items.size()), space(head) );
+            for ( size_type i = 0; i != towrite; ++i ) {
+                mitems[head] = items[i];
+                head = next(head);
+            }
+            os::MemoryFence();
+            mhead = head;
+            droppedSamples.add( items.size() - towrite );
+            return towrite;
+        }
+
+        bool Pop( reference_t item )
+        {
+            unsigned int tail = mtail;
+            if ( tail == mhead )
+                return false;
+            os::MemoryFence();
+            item = mitems[tail];
+            os::MemoryFence();
+            mtail = next(tail);
+            return true;
+        }
+
+        size_type Pop(std::vector<T>& items )
+        {
+            items.clear();
+            unsigned int tail = mtail;
+            unsigned int head = mhead;
+            os::MemoryFence();
+            for ( ; tail != head; tail = next(tail) )
+                items.push_back( mitems[tail] );
+            os::MemoryFence();
+            mtail = tail;
+            return items.size();
+        }
+
+        value_t* PopWithoutRelease()
+        {
+            unsigned int tail = mtail;
+            if ( tail == mhead )
+                return 0;
+            os::MemoryFence();
+            // the writer keeps off this slot until the next pop.
+            mtail = next(tail);
+            return &mitems[tail];
+        }
+
+        value_t* PopNewestWithoutRelease()
+        {
+            unsigned int head = mhead;
+            if ( mtail == head )
+                return 0;
+            os::MemoryFence();
+            mtail = head;
+            return &mitems[ head == 0 ? mslots - 1 : head - 1 ];
+        }
+
+        void Release(value_t *)
+        {
+            // the slot is reclaimed by the next pop.
+        }
+    };
+}}
+
+#endif
@@ -111,10 +111,10 @@ namespace RTT
         {
             typename std::vector<T>::const_iterator itl( items.begin() );
             if (mcircular && (size_type)items.size() >= cap ) {
+                // all current data and the oldest items are overwritten.
+                droppedSamples += buf.size() + items.size() - cap;
                 // clear out current data and reset iterator to first element we're going to take.
                 buf.clear();
-                //note the ignored samples are added below to the dropped samples.
-                droppedSamples += cap;
                 itl = items.begin() + ( items.size() - cap );
             } else if ( mcircular && (size_type)(buf.size() + items.size()) > cap) {
                 // drop excess elements from front
@@ -175,6 +175,17 @@ namespace RTT
 	    return 0;
 	}
 	
+	value_t* PopNewestWithoutRelease()
+	{
+	    if(buf.empty())
+		return 0;
+
+	    // only the newest sample is copied.
+	    lastSample = buf.back();
+	    buf.clear();
+	    return &lastSample;
+	}
+
 	void Release(value_t *item)
 	{
 	    //we do not need to release any memory, but we can check
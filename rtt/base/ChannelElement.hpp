@@ -43,6 +43,8 @@
 #include <boost/call_traits.hpp>
 #include "ChannelElementBase.hpp"
 #include "../FlowStatus.hpp"
+#include "../internal/SharedSample.hpp"
+#include <vector>
 
 namespace RTT { namespace base {
 
@@ -58,6 +60,7 @@ namespace RTT { namespace base {
         typedef boost::intrusive_ptr< ChannelElement<T> > shared_ptr;
         typedef typename boost::call_traits<T>::param_type param_t;
         typedef typename boost::call_traits<T>::reference reference_t;
+        typedef typename internal::SharedSample<T>::shared_ptr sample_ptr;
 
         shared_ptr getOutput()
         {
@@ -108,6 +111,21 @@ namespace RTT { namespace base {
             return false;
         }
 
+        /** Writes a batch of samples on this connection, in order. Elements
+         * that store samples override this to store the whole batch at once
+         * and to signal the reader only once.
+         *
+         * @returns false if an error occured that requires the channel to be invalidated.
+         */
+        virtual bool writeBatch(std::vector<value_t> const& samples)
+        {
+            typename std::vector<value_t>::const_iterator it;
+            for (it = samples.begin(); it != samples.end(); ++it)
+                if ( !this->write(*it) )
+                    return false;
+            return true;
+        }
+
         /** Reads a sample from the connection. \a sample is a reference which
          * will get updated if a sample is available. The method returns true
          * if a sample was available, and false otherwise. If false is returned,
@@ -121,6 +139,67 @@ namespace RTT { namespace base {
             else
                 return NoData;
         }
+
+        /** Reads all new samples from the connection, and returns the
+         * newest one in \a sample. Elements that store samples override
+         * this such that the older samples are not copied.
+         *
+         * @return NewData if at least one new sample was read, the result of
+         * read() otherwise.
+         */
+        virtual FlowStatus readNewest(reference_t sample, bool copy_old_data)
+        {
+            FlowStatus result = this->read(sample, copy_old_data);
+            if (result != NewData)
+                return result;
+            while (this->read(sample, false) == NewData);
+            return NewData;
+        }
+
+        /** Reads all new samples from the connection and appends them
+         * to \a samples, oldest first. Old data is never appended.
+         *
+         * @return NewData if at least one sample was appended, the result of
+         * read() otherwise.
+         */
+        virtual FlowStatus readBatch(std::vector<value_t>& samples)
+        {
+            value_t sample = this->data_sample();
+            FlowStatus result = this->read(sample, false);
+            if (result != NewData)
+                return result;
+            do {
+                samples.push_back(sample);
+            } while (this->read(sample, false) == NewData);
+            return NewData;
+        }
+
+        /** Writes a shared sample on this connection. Elements that
+         * do not store shared samples write a copy of the sample's data
+         * instead.
+         *
+         * @returns false if an error occured that requires the channel to be invalidated.
+         * @see OutputPort::shareSamples()
+         */
+        virtual bool writeShared(sample_ptr const& sample)
+        {
+            return this->write( sample->get() );
+        }
+
+        /** Reads a shared sample from the connection, without copying its
+         * data. Only connections that were created by an OutputPort in shared
+         * sample mode store shared samples, all other connections return NoData.
+         *
+         * @see OutputPort::shareSamples()
+         */
+        virtual FlowStatus readShared(sample_ptr& sample, bool copy_old_data)
+        {
+            typename ChannelElement<T>::shared_ptr input = this->getInput();
+            if (input)
+                return input->readShared(sample, copy_old_data);
+            else
+                return NoData;
+        }
     };
 }}
 
@@ -0,0 +1,147 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  DataObjectSeqLock.hpp
+
+                        DataObjectSeqLock.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef CORELIB_DATAOBJECT_SEQLOCK_HPP
+#define CORELIB_DATAOBJECT_SEQLOCK_HPP
+
+#include "../os/CAS.hpp"
+#include "DataObjectInterface.hpp"
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_pod.hpp>
+
+namespace RTT
+{ namespace base {
+
+    /**
+     * @brief A DataObject for plain old data types, protected by a
+     * sequence lock, such that any number of readers can read
+     * concurrently with the writers.
+     *
+     * Contrary to DataObjectLockFree, the data is stored only once, in a
+     * single slot which is padded to a cache line. A writer makes the
+     * sequence counter odd, writes the data and makes the counter
+     * even again. A reader copies the data and retries if the counter
+     * was odd or changed during the copy. Hence a Set() never fails,
+     * whatever the number of readers, and a Get() never returns a
+     * torn value. A reader may need to retry when a writer preempts
+     * it while copying, so Get() is lock-free, not wait-free.
+     *
+     * Since a reader may copy the data while it is being written,
+     * T must be a plain old data type. ConnFactory uses this data object
+     * for lock free data connections of such types.
+     * @ingroup PortBuffers
+     */
+    template<class T>
+    class DataObjectSeqLock
+        : public DataObjectInterface<T>
+    {
+        BOOST_STATIC_ASSERT( boost::is_pod<T>::value );
+    public:
+        /**
+         * The type of the data.
+         */
+        typedef T DataType;
+
+        /**
+         * The size of a cache line, used to pad the slot.
+         */
+        enum { CACHE_LINE_SIZE = 64 };
+    private:
+        char pad_front[CACHE_LINE_SIZE];
+        /**
+         * Odd while a writer is writing the data.
+         */
+        volatile unsigned int sequence;
+        DataType data;
+        char pad_back[CACHE_LINE_SIZE];
+
+    public:
+        /**
+         * Construct a DataObjectSeqLock.
+         *
+         * @param initial_value The initial value of this DataObject.
+         */
+        DataObjectSeqLock( const T& initial_value = T() )
+            : sequence(0), data(initial_value)
+        {
+        }
+
+        virtual DataType Get() const {DataType cache; Get(cache); return cache; }
+
+        /**
+         * Get a copy of the data. Retries as long as a writer
+         * is modifying the data.
+         *
+         * @param pull A copy of the data.
+         */
+        virtual void Get( DataType& pull ) const
+        {
+            unsigned int start;
+            do {
+                start = sequence;
+                if ( start & 1 )
+                    continue; // a writer is busy.
+                os::MemoryFence();
+                pull = data;
+                os::MemoryFence();
+            } while ( (start & 1) || start != sequence );
+        }
+
+        /**
+         * Set the data to a certain value. Concurrent writers are
+         * serialized, readers never block a writer.
+         *
+         * @param push The data which must be set.
+         */
+        virtual void Set( const DataType& push )
+        {
+            unsigned int start;
+            do {
+                start = sequence;
+            } while ( (start & 1) || !os::CAS(&sequence, start, start + 1) );
+            data = push;
+            // we own the odd sequence number, so this can not fail.
+            os::CAS(&sequence, start + 1, start + 2);
+        }
+
+        virtual void data_sample( const DataType& sample ) {
+            Set( sample );
+        }
+    };
+}}
+
+#endif
@@ -59,6 +59,14 @@ namespace RTT
         {
         protected:
             ExecutionEngine* engine;
+        private:
+            friend class RTT::ExecutionEngine;
+            /**
+             * Links in the list of running functions of the engine,
+             * only used by the thread of that engine.
+             */
+            ExecutableInterface* next_function;
+            ExecutableInterface* prev_function;
         public:
             /**
              * Called by the ExecutionEngine \a ee to tell
@@ -77,7 +85,7 @@ namespace RTT
              */
             void unloaded() { this->unloading(); engine = 0;}
 
-            ExecutableInterface() : engine(0) {}
+            ExecutableInterface() : engine(0), next_function(0), prev_function(0) {}
             virtual ~ExecutableInterface() {}
 
             /**
@@ -46,7 +46,7 @@ using namespace RTT::detail;
 using namespace std;
 
 PortInterface::PortInterface(const std::string& name)
-    : name(name), iface(0) {}
+    : name(name), mevent_slot(-1), mevent_pending(0), iface(0) {}
 
 bool PortInterface::setName(const std::string& name)
 {
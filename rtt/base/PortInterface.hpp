@@ -58,6 +58,14 @@ namespace RTT
     {
         std::string name;
         std::string mdesc;
+
+        friend class internal::PortEventSet;
+        /**
+         * The index of this port in the event port table of its
+         * TaskContext, or -1, and whether the port is queued there.
+         */
+        int mevent_slot;
+        volatile int mevent_pending;
     protected:
         DataFlowInterface* iface;
 
@@ -43,6 +43,7 @@
 #include "../rtt-fwd.hpp"
 #include "../rtt-config.h"
 #include "../Time.hpp"
+#include "../os/CycleStatistics.hpp"
 
 namespace RTT
 { namespace base {
@@ -337,6 +338,15 @@ namespace RTT
             return ee;
         }
 
+        /**
+         * Returns the execution time statistics of updateHook(),
+         * recorded by the ExecutionEngine.
+         */
+        os::CycleStatistics& getCycleStatistics()
+        {
+            return mCycleStatistics;
+        }
+
     protected:
         /**
          * Implement this method such that it contains the code which
@@ -458,6 +468,10 @@ namespace RTT
          * mTaskState to mTargetState.
          */
         TaskState mTargetState;
+        /**
+         * Execution times of prepareUpdateHook() and updateHook().
+         */
+        os::CycleStatistics mCycleStatistics;
         // non copyable
         TaskCore( TaskCore& );
 
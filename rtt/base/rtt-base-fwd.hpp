@@ -39,10 +39,14 @@ namespace RTT {
         template<class T>
         class BufferUnSync;
         template<class T>
+        class BufferSPSC;
+        template<class T>
         class DataObjectLockFree;
         template<class T>
         class DataObjectLocked;
         template<class T>
+        class DataObjectSeqLock;
+        template<class T>
         class DataObjectUnSync;
         template<typename T>
         class ChannelElement;
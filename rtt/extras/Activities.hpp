@@ -47,7 +47,10 @@
  * Activities execute functions in a thread.
  */
 #include "SlaveActivity.hpp"
+#include "DataFlowActivity.hpp"
+#include "GroupActivity.hpp"
 #include "SequentialActivity.hpp"
+#include "ThreadPoolActivity.hpp"
 #include "PeriodicActivity.hpp"
 #include "../Activity.hpp"
 #include "../base/RunnableInterface.hpp"
@@ -0,0 +1,157 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  ActivityGroup.cpp
+
+                        ActivityGroup.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "ActivityGroup.hpp"
+#include "GroupActivity.hpp"
+#include "../os/MutexLock.hpp"
+
+namespace RTT
+{ namespace extras {
+
+    using namespace detail;
+
+    ActivityGroup::ActivityGroup(Seconds period, bool barrier)
+        : mperiod( Seconds_to_nsecs(period) ), mepoch(0), mbarrier(barrier),
+          mmembers(0), marrived(0), mcycles(0), moverruns(0), mmax_latency(0)
+    {
+        if ( mperiod <= 0 )
+            mperiod = 1;
+    }
+
+    ActivityGroup::~ActivityGroup()
+    {
+    }
+
+    Seconds ActivityGroup::getPeriod() const
+    {
+        return nsecs_to_Seconds(mperiod);
+    }
+
+    bool ActivityGroup::hasBarrier() const
+    {
+        return mbarrier;
+    }
+
+    unsigned int ActivityGroup::getMemberCount() const
+    {
+        MutexLock lock(mlock);
+        return mmembers;
+    }
+
+    unsigned int ActivityGroup::getCycleCount() const
+    {
+        MutexLock lock(mlock);
+        return mcycles;
+    }
+
+    unsigned int ActivityGroup::getOverrunCount() const
+    {
+        MutexLock lock(mlock);
+        return moverruns;
+    }
+
+    Seconds ActivityGroup::getMaxLatency() const
+    {
+        MutexLock lock(mlock);
+        return nsecs_to_Seconds(mmax_latency);
+    }
+
+    void ActivityGroup::resetStatistics()
+    {
+        MutexLock lock(mlock);
+        moverruns = 0;
+        mmax_latency = 0;
+    }
+
+    void ActivityGroup::join(GroupActivity* m)
+    {
+        NANO_TIME now = rtos_get_time_ns();
+        // restart the periods when the first member starts.
+        if ( mmembers == 0 )
+            mepoch = now - mcycles * mperiod;
+        ++mmembers;
+        m->marrived = false;
+        if ( mbarrier ) {
+            m->mcycle = mcycles;
+        } else {
+            // the first release which is not in the past.
+            NANO_TIME since = now - mepoch - m->mphase;
+            m->mcycle = since > 0 ? (since + mperiod - 1) / mperiod : 0;
+        }
+    }
+
+    void ActivityGroup::leave(GroupActivity* m)
+    {
+        --mmembers;
+        if ( m->marrived && m->marrived_cycle == mcycles )
+            --marrived;
+        m->marrived = false;
+        if ( mbarrier && mmembers != 0 && marrived >= mmembers )
+            completeCycle();
+        mcond.broadcast();
+    }
+
+    void ActivityGroup::arrive(GroupActivity* m)
+    {
+        unsigned int cycle = mcycles;
+        m->marrived = true;
+        m->marrived_cycle = cycle;
+        ++marrived;
+        if ( marrived >= mmembers )
+            completeCycle();
+        while ( cycle == mcycles && !m->mbreak )
+            mcond.wait(mlock);
+        // when stopped while waiting, leave() takes us off the barrier.
+        if ( cycle != mcycles )
+            m->marrived = false;
+    }
+
+    void ActivityGroup::completeCycle()
+    {
+        marrived = 0;
+        ++mcycles;
+        // skip the periods which already ended.
+        NANO_TIME now = rtos_get_time_ns();
+        unsigned int current = (now - mepoch) / mperiod;
+        if ( current > mcycles ) {
+            ++moverruns;
+            mcycles = current;
+        }
+        mcond.broadcast();
+    }
+
+}}
@@ -0,0 +1,163 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  ActivityGroup.hpp
+
+                        ActivityGroup.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_ACTIVITY_GROUP_HPP
+#define ORO_ACTIVITY_GROUP_HPP
+
+#include "../os/Mutex.hpp"
+#include "../os/Condition.hpp"
+#include "../os/fosi.h"
+#include "../Time.hpp"
+
+namespace RTT
+{ namespace extras {
+
+    class GroupActivity;
+
+    /**
+     * @brief A common period for a group of GroupActivity objects.
+     *
+     * Each member of the group is released once per period, at its own
+     * phase offset from the start of the period. Members which share a
+     * period but do not need to run at the same instant can so be
+     * spread over the period instead of contending for the processors.
+     *
+     * With a barrier, each member waits at the end of its cycle until
+     * all members finished that cycle. The outputs of cycle N are then
+     * complete before any member starts cycle N+1. When the barrier
+     * is passed after the end of the period, the group skips the
+     * periods it missed and counts one overrun.
+     *
+     * Without a barrier, a member which is released more than a period
+     * late skips the periods it missed and counts one overrun.
+     *
+     * The group must outlive its members.
+     * @ingroup CoreLibActivities
+     */
+    class RTT_API ActivityGroup
+    {
+    public:
+        /**
+         * Create a group.
+         * @param period The common period of all members, in seconds.
+         * @param barrier Join the members at the end of each cycle.
+         */
+        ActivityGroup(Seconds period, bool barrier = false);
+
+        ~ActivityGroup();
+
+        Seconds getPeriod() const;
+
+        bool hasBarrier() const;
+
+        /**
+         * Returns the number of started members.
+         */
+        unsigned int getMemberCount() const;
+
+        /**
+         * Returns the number of periods since the group started,
+         * up to the last period in which a member was released.
+         */
+        unsigned int getCycleCount() const;
+
+        /**
+         * Returns the number of overruns of the group.
+         */
+        unsigned int getOverrunCount() const;
+
+        /**
+         * Returns the largest delay between the release time of a
+         * member and the start of its cycle, in seconds.
+         */
+        Seconds getMaxLatency() const;
+
+        /**
+         * Clear the overrun count and the largest latency.
+         */
+        void resetStatistics();
+
+    private:
+        friend class GroupActivity;
+        ActivityGroup(const ActivityGroup&);
+
+        /**
+         * Adds \a m to the started members and sets its first cycle.
+         * @pre mlock is held.
+         */
+        void join(GroupActivity* m);
+
+        /**
+         * Removes \a m from the started members.
+         * @pre mlock is held.
+         */
+        void leave(GroupActivity* m);
+
+        /**
+         * Waits at the barrier until all members finished the current cycle.
+         * @pre mlock is held.
+         */
+        void arrive(GroupActivity* m);
+
+        /**
+         * Passes the barrier and wakes up the waiting members.
+         * @pre mlock is held.
+         */
+        void completeCycle();
+
+        NANO_TIME mperiod;
+        NANO_TIME mepoch;
+        bool mbarrier;
+        unsigned int mmembers;
+        /**
+         * The number of members waiting at the barrier.
+         */
+        unsigned int marrived;
+        /**
+         * The current cycle of the barrier, or the highest cycle
+         * started by a member.
+         */
+        unsigned int mcycles;
+        unsigned int moverruns;
+        NANO_TIME mmax_latency;
+        mutable os::Mutex mlock;
+        os::Condition mcond;
+    };
+
+}}
+
+#endif
@@ -0,0 +1,198 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  DataFlowActivity.cpp
+
+                        DataFlowActivity.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "DataFlowActivity.hpp"
+#include "SlaveActivity.hpp"
+#include "../TaskContext.hpp"
+#include "../os/MutexLock.hpp"
+#include "../internal/ConnFactory.hpp"
+#include "../Logger.hpp"
+#include <algorithm>
+#include <map>
+
+namespace RTT
+{ namespace extras {
+
+    using namespace detail;
+
+    DataFlowActivity::DataFlowActivity(int scheduler, int priority, Seconds period,
+                                       unsigned cpu_affinity, const std::string& name)
+        : Activity(scheduler, priority, period, cpu_affinity, 0, name)
+    {
+    }
+
+    DataFlowActivity::~DataFlowActivity()
+    {
+        stop();
+    }
+
+    bool DataFlowActivity::addComponent(TaskContext* tc)
+    {
+        if ( !tc || !this->isActive() || tc->isRunning() )
+            return false;
+        MutexLock lock(mlock);
+        for (std::vector<Component>::iterator it = mcomponents.begin(); it != mcomponents.end(); ++it)
+            if ( it->tc == tc )
+                return false;
+        Component c;
+        c.tc = tc;
+        c.slave = new SlaveActivity(this);
+        // the component owns the slave from here on.
+        if ( !tc->setActivity( c.slave ) )
+            return false;
+        mcomponents.push_back(c);
+        computeSchedule();
+        return true;
+    }
+
+    bool DataFlowActivity::removeComponent(TaskContext* tc)
+    {
+        if ( !tc || tc->isRunning() )
+            return false;
+        MutexLock lock(mlock);
+        for (std::vector<Component>::iterator it = mcomponents.begin(); it != mcomponents.end(); ++it)
+            if ( it->tc == tc ) {
+                mcomponents.erase(it);
+                computeSchedule();
+                tc->setActivity(0);
+                return true;
+            }
+        return false;
+    }
+
+    bool DataFlowActivity::updateSchedule()
+    {
+        MutexLock lock(mlock);
+        return computeSchedule();
+    }
+
+    std::vector<TaskContext*> DataFlowActivity::getSchedule() const
+    {
+        MutexLock lock(mlock);
+        std::vector<TaskContext*> result;
+        for (std::vector<Component>::const_iterator it = morder.begin(); it != morder.end(); ++it)
+            result.push_back( it->tc );
+        return result;
+    }
+
+    std::vector<TaskContext*> DataFlowActivity::getCyclicComponents() const
+    {
+        MutexLock lock(mlock);
+        return mcyclic;
+    }
+
+    bool DataFlowActivity::computeSchedule()
+    {
+        const unsigned int n = mcomponents.size();
+        std::map<const TaskContext*, unsigned int> index;
+        for (unsigned int i = 0; i != n; ++i)
+            index[ mcomponents[i].tc ] = i;
+
+        // edges[i] lists the components reading from component i.
+        std::vector< std::vector<unsigned int> > edges(n);
+        std::vector<unsigned int> indegree(n, 0);
+        for (unsigned int i = 0; i != n; ++i) {
+            DataFlowInterface::Ports ports = mcomponents[i].tc->ports()->getPorts();
+            for (DataFlowInterface::Ports::iterator p = ports.begin(); p != ports.end(); ++p) {
+                if ( !dynamic_cast<OutputPortInterface*>(*p) )
+                    continue;
+                std::list<ConnectionManager::ChannelDescriptor> channels = (*p)->getManager()->getChannels();
+                for (std::list<ConnectionManager::ChannelDescriptor>::iterator c = channels.begin(); c != channels.end(); ++c) {
+                    LocalConnID* id = dynamic_cast<LocalConnID*>( c->get<0>().get() );
+                    if ( !id || !id->ptr || !id->ptr->getInterface() )
+                        continue;
+                    std::map<const TaskContext*, unsigned int>::iterator j = index.find( id->ptr->getInterface()->getOwner() );
+                    if ( j == index.end() || j->second == i )
+                        continue;
+                    if ( std::find(edges[i].begin(), edges[i].end(), j->second) != edges[i].end() )
+                        continue;
+                    edges[i].push_back( j->second );
+                    ++indegree[ j->second ];
+                }
+            }
+        }
+
+        // Kahn's algorithm, which prefers the component added first.
+        morder.clear();
+        mcyclic.clear();
+        std::vector<bool> done(n, false);
+        bool progress = true;
+        while ( progress ) {
+            progress = false;
+            for (unsigned int i = 0; i != n; ++i) {
+                if ( done[i] || indegree[i] != 0 )
+                    continue;
+                done[i] = true;
+                morder.push_back( mcomponents[i] );
+                for (std::vector<unsigned int>::iterator e = edges[i].begin(); e != edges[i].end(); ++e)
+                    --indegree[*e];
+                progress = true;
+                break;
+            }
+        }
+        if ( morder.size() == n )
+            return true;
+
+        Logger::In in( this->getName() );
+        log(Error) << "Data flow cycle between the components:";
+        for (unsigned int i = 0; i != n; ++i)
+            if ( !done[i] ) {
+                morder.push_back( mcomponents[i] );
+                mcyclic.push_back( mcomponents[i].tc );
+                log() << " " << mcomponents[i].tc->getName();
+            }
+        log() << ". These are executed last, in the order in which they were added." << endlog();
+        return false;
+    }
+
+    bool DataFlowActivity::initialize()
+    {
+        MutexLock lock(mlock);
+        computeSchedule();
+        return true;
+    }
+
+    void DataFlowActivity::step()
+    {
+        MutexLock lock(mlock);
+        for (std::vector<Component>::iterator it = morder.begin(); it != morder.end(); ++it)
+            // skip components of which the activity was replaced.
+            if ( it->tc->getActivity() == it->slave )
+                it->slave->execute();
+    }
+
+}}
@@ -0,0 +1,160 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  DataFlowActivity.hpp
+
+                        DataFlowActivity.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_DATA_FLOW_ACTIVITY_HPP
+#define ORO_DATA_FLOW_ACTIVITY_HPP
+
+#include "../Activity.hpp"
+#include "../os/Mutex.hpp"
+#include "../rtt-fwd.hpp"
+#include <vector>
+
+namespace RTT
+{ namespace extras {
+
+    class SlaveActivity;
+
+    /**
+     * @brief An Activity which executes a set of components in one
+     * thread, in the order of the data flow between them.
+     *
+     * Each added component gets a SlaveActivity of which this activity
+     * is the master. In each step, the components are executed such
+     * that a component which writes to an input port of another
+     * component is executed before that component. Hence a sample
+     * travels from a sensor component to an actuator component in a
+     * single step, instead of in one step per component.
+     *
+     * The order is derived from the local connections of the output
+     * ports of the components, when this activity starts and after
+     * each call to updateSchedule(). Call updateSchedule() when you
+     * connect or disconnect ports while this activity is running.
+     * Components which form a data flow cycle are executed after all
+     * other components, in the order in which they were added, and are
+     * reported with getCyclicComponents().
+     *
+     * Triggering one of the components triggers this activity.
+     * Remove all components before destroying this activity.
+     * @ingroup CoreLibActivities
+     */
+    class RTT_API DataFlowActivity
+        : public Activity
+    {
+    public:
+        /**
+         * Create a DataFlowActivity with a given scheduler type, priority
+         * and period.
+         * @param scheduler The scheduler in which the activity's thread must run.
+         * @param priority The priority of this activity.
+         * @param period The periodicity of this activity, zero for a
+         * non periodic activity which runs when triggered.
+         * @param cpu_affinity The prefered cpu to run on.
+         * @param name The name of the underlying thread.
+         */
+        DataFlowActivity(int scheduler, int priority, Seconds period,
+                         unsigned cpu_affinity = ~0,
+                         const std::string& name = "DataFlowActivity");
+
+        /**
+         * Stops this activity.
+         */
+        ~DataFlowActivity();
+
+        /**
+         * Execute \a tc in this activity. Replaces the activity of
+         * \a tc by a SlaveActivity.
+         * @return false if this activity is not active, if \a tc is
+         * running or if it was already added.
+         */
+        bool addComponent(TaskContext* tc);
+
+        /**
+         * Stop executing \a tc in this activity. \a tc gets a default
+         * activity.
+         * @return false if \a tc is running or was not added.
+         */
+        bool removeComponent(TaskContext* tc);
+
+        /**
+         * Recompute the execution order from the current connections.
+         * @return false if the components contain a data flow cycle.
+         */
+        bool updateSchedule();
+
+        /**
+         * Returns the components in the order in which they
+         * are executed.
+         */
+        std::vector<TaskContext*> getSchedule() const;
+
+        /**
+         * Returns the components which are part of, or depend on,
+         * a data flow cycle.
+         */
+        std::vector<TaskContext*> getCyclicComponents() const;
+
+        virtual bool initialize();
+
+        virtual void step();
+
+    private:
+        struct Component {
+            TaskContext* tc;
+            SlaveActivity* slave;
+        };
+
+        /**
+         * Computes morder from mcomponents.
+         * @pre mlock is held.
+         */
+        bool computeSchedule();
+
+        /**
+         * The components, in the order in which they were added.
+         */
+        std::vector<Component> mcomponents;
+        /**
+         * The components, in the order in which they are executed.
+         */
+        std::vector<Component> morder;
+        std::vector<TaskContext*> mcyclic;
+        mutable os::Mutex mlock;
+    };
+
+}}
+
+#endif
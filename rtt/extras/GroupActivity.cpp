@@ -0,0 +1,169 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  GroupActivity.cpp
+
+                        GroupActivity.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "GroupActivity.hpp"
+#include "../os/MutexLock.hpp"
+#include <cmath>
+
+namespace RTT
+{ namespace extras {
+
+    using namespace detail;
+
+    namespace {
+        /**
+         * Releases a locked mutex for as long as it exists.
+         */
+        struct MutexUnlock {
+            os::Mutex& m;
+            MutexUnlock(os::Mutex& mutex) : m(mutex) { m.unlock(); }
+            ~MutexUnlock() { m.lock(); }
+        };
+    }
+
+    GroupActivity::GroupActivity(ActivityGroup* group, Seconds phase, int scheduler, int priority,
+                                 unsigned cpu_affinity, base::RunnableInterface* r, const std::string& name)
+        : Activity(scheduler, priority, 0.0, cpu_affinity, r, name),
+          mgroup(group), mphase(0), mcycle(0), marrived_cycle(0), marrived(false), mbreak(false)
+    {
+        mphase = Seconds_to_nsecs( std::fmod(phase, group->getPeriod()) );
+        if ( mphase < 0 )
+            mphase += group->mperiod;
+    }
+
+    GroupActivity::~GroupActivity()
+    {
+        stop();
+    }
+
+    ActivityGroup* GroupActivity::getGroup() const
+    {
+        return mgroup;
+    }
+
+    Seconds GroupActivity::getPhase() const
+    {
+        return nsecs_to_Seconds(mphase);
+    }
+
+    Seconds GroupActivity::getPeriod() const
+    {
+        return mgroup->getPeriod();
+    }
+
+    bool GroupActivity::setPeriod(Seconds)
+    {
+        return false;
+    }
+
+    bool GroupActivity::isPeriodic() const
+    {
+        return true;
+    }
+
+    bool GroupActivity::trigger()
+    {
+        return false;
+    }
+
+    bool GroupActivity::initialize()
+    {
+        if ( !Activity::initialize() )
+            return false;
+        MutexLock lock(mgroup->mlock);
+        mbreak = false;
+        mgroup->join(this);
+        return true;
+    }
+
+    void GroupActivity::loop()
+    {
+        ActivityGroup& g = *mgroup;
+        MutexLock lock(g.mlock);
+        while ( !mbreak ) {
+            NANO_TIME release = g.mepoch + mcycle * g.mperiod + mphase;
+            while ( !mbreak && rtos_get_time_ns() < release )
+                g.mcond.wait_until(g.mlock, release);
+            if ( mbreak )
+                break;
+
+            NANO_TIME late = rtos_get_time_ns() - release;
+            if ( late > g.mmax_latency )
+                g.mmax_latency = late;
+            if ( !g.mbarrier ) {
+                if ( late >= g.mperiod ) {
+                    // skip the releases we missed.
+                    ++g.moverruns;
+                    mcycle += late / g.mperiod;
+                }
+                if ( mcycle >= g.mcycles )
+                    g.mcycles = mcycle + 1;
+            }
+
+            {
+                MutexUnlock unlock(g.mlock);
+                Activity::step();
+            }
+
+            if ( g.mbarrier ) {
+                g.arrive(this);
+                mcycle = g.mcycles;
+            } else
+                ++mcycle;
+        }
+    }
+
+    bool GroupActivity::breakLoop()
+    {
+        MutexLock lock(mgroup->mlock);
+        mbreak = true;
+        mgroup->mcond.broadcast();
+        return true;
+    }
+
+    void GroupActivity::finalize()
+    {
+        {
+            MutexLock lock(mgroup->mlock);
+            // in case stop() came before loop() was entered.
+            mbreak = true;
+            mgroup->leave(this);
+        }
+        Activity::finalize();
+    }
+
+}}
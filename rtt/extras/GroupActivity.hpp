@@ -0,0 +1,122 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  GroupActivity.hpp
+
+                        GroupActivity.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_GROUP_ACTIVITY_HPP
+#define ORO_GROUP_ACTIVITY_HPP
+
+#include "ActivityGroup.hpp"
+#include "../Activity.hpp"
+
+namespace RTT
+{ namespace extras {
+
+    /**
+     * @brief A periodic Activity which is a member of an ActivityGroup.
+     *
+     * It has its own thread, which runs step() once per period of the
+     * group, at a phase offset from the start of that period. If the
+     * group has a barrier, the thread waits at the end of each step
+     * until all members of the group finished their step.
+     *
+     * Since the activity is periodic, trigger() is ignored.
+     * @ingroup CoreLibActivities
+     */
+    class RTT_API GroupActivity
+        : public Activity
+    {
+    public:
+        /**
+         * Create a member of \a group.
+         * @param group The group of this activity, which must outlive it.
+         * @param phase The offset of the release time from the start of
+         * each period, in seconds. It is taken modulo the period.
+         * @param scheduler The scheduler in which the activity's thread must run.
+         * @param priority The priority of this activity.
+         * @param cpu_affinity The prefered cpu to run on (a mask).
+         * @param r The optional base::RunnableInterface to run.
+         * @param name The name of the underlying thread.
+         */
+        GroupActivity(ActivityGroup* group, Seconds phase, int scheduler, int priority,
+                      unsigned cpu_affinity = ~0, base::RunnableInterface* r = 0,
+                      const std::string& name = "GroupActivity");
+
+        ~GroupActivity();
+
+        ActivityGroup* getGroup() const;
+
+        Seconds getPhase() const;
+
+        virtual Seconds getPeriod() const;
+
+        /**
+         * The period is set by the group.
+         * @return false
+         */
+        virtual bool setPeriod(Seconds period);
+
+        virtual bool isPeriodic() const;
+
+        virtual bool trigger();
+
+        virtual bool initialize();
+
+        virtual void loop();
+
+        virtual bool breakLoop();
+
+        virtual void finalize();
+
+    private:
+        friend class ActivityGroup;
+
+        ActivityGroup* mgroup;
+        NANO_TIME mphase;
+        /**
+         * The next cycle of this member.
+         */
+        unsigned int mcycle;
+        /**
+         * The barrier cycle this member arrived at, if waiting.
+         */
+        unsigned int marrived_cycle;
+        bool marrived;
+        bool mbreak;
+    };
+
+}}
+
+#endif
@@ -0,0 +1,180 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  ThreadPool.cpp
+
+                        ThreadPool.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "ThreadPool.hpp"
+#include "ThreadPoolActivity.hpp"
+#include "../Activity.hpp"
+#include "../base/RunnableInterface.hpp"
+#include "../Logger.hpp"
+#include <sstream>
+
+namespace RTT
+{ namespace extras {
+
+    /**
+     * Takes queued activities until the pool quits.
+     */
+    class ThreadPool::Worker
+        : public base::RunnableInterface
+    {
+        ThreadPool* mpool;
+        unsigned int mindex;
+    public:
+        Worker(ThreadPool* pool, unsigned int index) : mpool(pool), mindex(index) {}
+
+        bool initialize() { return true; }
+        void step() {}
+        void finalize() {}
+
+        void loop()
+        {
+            const unsigned int count = mpool->mqueues.size();
+            while (true) {
+                // each queued activity posted one count.
+                mpool->mwork.wait();
+                if (mpool->mquit)
+                    return;
+                ThreadPoolActivity* act = 0;
+                // our own queue first, then steal from the others.
+                for (unsigned int i = 0; ; i = (i + 1) % count)
+                    if ( mpool->mqueues[(mindex + i) % count]->dequeue(act) )
+                        break;
+                act->work(this->getActivity()->thread(), mindex);
+            }
+        }
+
+        bool breakLoop()
+        {
+            // the pool posted a wake-up for each worker.
+            return mpool->mquit;
+        }
+    };
+
+    ThreadPool::ThreadPool(unsigned int workers, int scheduler, int priority,
+                           unsigned cpu_affinity, unsigned int max_activities,
+                           const std::string& name)
+        : mwork(0), mattached(0), mmax_activities(max_activities), mquit(false),
+          mscheduler(scheduler), mpriority(priority), mcpu_affinity(cpu_affinity),
+          mname(name), midle(scheduler, priority, 0.0, cpu_affinity, name + "Idle")
+    {
+        if (workers == 0)
+            workers = 1;
+        for (unsigned int i = 0; i != workers; ++i) {
+            // an activity is queued at most once, so this never overflows.
+            mqueues.push_back( new Queue(max_activities + 1) );
+            mworkers.push_back( new Worker(this, i) );
+        }
+        for (unsigned int i = 0; i != workers; ++i) {
+            std::stringstream worker_name;
+            worker_name << name << i;
+            mthreads.push_back( new Activity(scheduler, priority, 0.0, cpu_affinity, mworkers[i], worker_name.str()) );
+            mthreads.back()->start();
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        mquit = true;
+        for (unsigned int i = 0; i != mthreads.size(); ++i)
+            mwork.signal();
+        for (unsigned int i = 0; i != mthreads.size(); ++i) {
+            mthreads[i]->stop();
+            delete mthreads[i];
+            delete mworkers[i];
+            delete mqueues[i];
+        }
+    }
+
+    unsigned int ThreadPool::getWorkerCount() const
+    {
+        return mthreads.size();
+    }
+
+    int ThreadPool::getScheduler() const
+    {
+        return mscheduler;
+    }
+
+    int ThreadPool::getPriority() const
+    {
+        return mpriority;
+    }
+
+    unsigned ThreadPool::getCpuAffinity() const
+    {
+        return mcpu_affinity;
+    }
+
+    const std::string& ThreadPool::getName() const
+    {
+        return mname;
+    }
+
+    bool ThreadPool::attach()
+    {
+        mattached.inc();
+        if ( mattached.read() > (int)mmax_activities ) {
+            mattached.dec();
+            log(Error) << "ThreadPool " << mname << " can not run more than "
+                       << mmax_activities << " activities." << endlog();
+            return false;
+        }
+        return true;
+    }
+
+    void ThreadPool::detach()
+    {
+        mattached.dec();
+    }
+
+    bool ThreadPool::schedule(ThreadPoolActivity* act, unsigned int worker)
+    {
+        const unsigned int count = mqueues.size();
+        for (unsigned int i = 0; i != count; ++i)
+            if ( mqueues[(worker + i) % count]->enqueue(act) ) {
+                mwork.signal();
+                return true;
+            }
+        return false;
+    }
+
+    os::ThreadInterface* ThreadPool::idleThread()
+    {
+        return &midle;
+    }
+
+}}
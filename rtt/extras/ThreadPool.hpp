@@ -0,0 +1,146 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  ThreadPool.hpp
+
+                        ThreadPool.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_THREAD_POOL_HPP
+#define ORO_THREAD_POOL_HPP
+
+#include "../os/Thread.hpp"
+#include "../os/Semaphore.hpp"
+#include "../os/Atomic.hpp"
+#include "../os/threads.hpp"
+#include "../base/ActivityInterface.hpp"
+#include "../internal/AtomicQueue.hpp"
+#include <boost/shared_ptr.hpp>
+#include <vector>
+#include <string>
+
+namespace RTT
+{ namespace extras {
+
+    class ThreadPoolActivity;
+
+    /**
+     * @brief A fixed number of worker threads which execute the
+     * ThreadPoolActivity objects that use this pool.
+     *
+     * Each worker has its own queue of triggered activities. An activity
+     * is queued at the worker that executed it last, and a worker that
+     * finds its own queue empty steals from the queues of the others.
+     * All workers share the scheduler, priority and CPU affinity of the
+     * pool, so create one pool per priority class.
+     *
+     * Use this instead of one Activity per component when many
+     * non periodic components mostly wait for data.
+     *
+     * @ingroup CoreLibActivities
+     */
+    class RTT_API ThreadPool
+    {
+    public:
+        typedef boost::shared_ptr<ThreadPool> shared_ptr;
+
+        /**
+         * Creates and starts the worker threads of the pool.
+         * @param workers The number of worker threads, at least one.
+         * @param scheduler The scheduler of the workers, ORO_SCHED_OTHER or ORO_SCHED_RT.
+         * @param priority The priority of the workers.
+         * @param cpu_affinity The CPU affinity mask of the workers.
+         * @param max_activities The maximum number of activities that may use this pool.
+         * @param name The name of the pool, which is used to name the workers.
+         */
+        ThreadPool(unsigned int workers, int scheduler = ORO_SCHED_OTHER, int priority = os::LowestPriority,
+                   unsigned cpu_affinity = ~0, unsigned int max_activities = 256,
+                   const std::string& name = "ThreadPool");
+
+        /**
+         * Stops the workers. All activities using the pool must be
+         * destroyed first, which their shared pointer to the pool ensures.
+         */
+        ~ThreadPool();
+
+        unsigned int getWorkerCount() const;
+
+        int getScheduler() const;
+
+        int getPriority() const;
+
+        unsigned getCpuAffinity() const;
+
+        const std::string& getName() const;
+
+    private:
+        friend class ThreadPoolActivity;
+        class Worker;
+
+        /**
+         * Registers an activity, fails if max_activities is reached.
+         */
+        bool attach();
+        void detach();
+
+        /**
+         * Queues \a act for execution, preferably on \a worker.
+         */
+        bool schedule(ThreadPoolActivity* act, unsigned int worker);
+
+        /**
+         * Returns the thread that stands in for idle activities.
+         * It never runs anything, so no thread is ever 'self' for it.
+         */
+        os::ThreadInterface* idleThread();
+
+        typedef internal::AtomicQueue<ThreadPoolActivity*> Queue;
+        std::vector<Queue*> mqueues;
+        std::vector<Worker*> mworkers;
+        std::vector<base::ActivityInterface*> mthreads;
+        /** Counts the queued activities, the workers wait on it. */
+        os::Semaphore mwork;
+        os::AtomicInt mattached;
+        const unsigned int mmax_activities;
+        volatile bool mquit;
+        const int mscheduler;
+        const int mpriority;
+        const unsigned mcpu_affinity;
+        const std::string mname;
+        os::Thread midle;
+
+        ThreadPool(const ThreadPool&);
+    };
+
+}}
+
+#endif
@@ -0,0 +1,199 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  ThreadPoolActivity.cpp
+
+                        ThreadPoolActivity.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "ThreadPoolActivity.hpp"
+#include "../os/CAS.hpp"
+#include "../os/fosi.h"
+
+namespace RTT {
+    using namespace extras;
+    using namespace base;
+
+    ThreadPoolActivity::ThreadPoolActivity( ThreadPool::shared_ptr pool, RunnableInterface* run /*= 0*/ )
+        : ActivityInterface(run), mpool(pool), mattached(pool->attach()), active(false),
+          mstate(Idle), mcurrent(0), mworker(0)
+    {
+    }
+
+    ThreadPoolActivity::~ThreadPoolActivity()
+    {
+        stop();
+        // a worker may still hold us in a queue.
+        TIME_SPEC ts;
+        ts.tv_sec = 0;
+        ts.tv_nsec = 1000;
+        while ( mstate != Idle )
+            rtos_nanosleep(&ts, NULL);
+        if (mattached)
+            mpool->detach();
+    }
+
+    ThreadPool::shared_ptr ThreadPoolActivity::getPool() const
+    {
+        return mpool;
+    }
+
+    Seconds ThreadPoolActivity::getPeriod() const
+    {
+        return 0.0;
+    }
+
+    bool ThreadPoolActivity::setPeriod(Seconds s) {
+        if ( s == 0.0)
+            return true;
+        return false;
+    }
+
+    unsigned ThreadPoolActivity::getCpuAffinity() const
+    {
+        return mpool->getCpuAffinity();
+    }
+
+    bool ThreadPoolActivity::setCpuAffinity(unsigned cpu)
+    {
+        // the affinity is set per pool.
+        return false;
+    }
+
+    os::ThreadInterface* ThreadPoolActivity::thread()
+    {
+        // only the worker that executes us sets mcurrent, so a stale
+        // value can never make another caller 'self'.
+        os::ThreadInterface* current = mcurrent;
+        return current ? current : mpool->idleThread();
+    }
+
+    bool ThreadPoolActivity::start()
+    {
+        if ( active || !mattached )
+            return false;
+        active = true;
+        if ( runner ? !runner->initialize() : false ) {
+            active = false;
+            return false;
+        }
+        // like a thread, execute once when started.
+        return trigger();
+    }
+
+    bool ThreadPoolActivity::stop()
+    {
+        if ( !active )
+            return false;
+        active = false;
+        // wait until the worker returns from loop(), unless we are that worker.
+        if ( isRunning() && !thread()->isSelf() ) {
+            if (runner)
+                runner->breakLoop();
+            TIME_SPEC ts;
+            ts.tv_sec = 0;
+            ts.tv_nsec = 1000;
+            while ( isRunning() )
+                rtos_nanosleep(&ts, NULL);
+        }
+        if (runner)
+            runner->finalize();
+        return true;
+    }
+
+    bool ThreadPoolActivity::isRunning() const
+    {
+        return mstate == Running || mstate == Retriggered;
+    }
+
+    bool ThreadPoolActivity::isPeriodic() const
+    {
+        return false;
+    }
+
+    bool ThreadPoolActivity::isActive() const
+    {
+        return active;
+    }
+
+    bool ThreadPoolActivity::execute()
+    {
+        return false;
+    }
+
+    bool ThreadPoolActivity::trigger()
+    {
+        if ( !active )
+            return false;
+        while (true) {
+            int state = mstate;
+            switch (state) {
+            case Idle:
+                if ( os::CAS(&mstate, (int)Idle, (int)Queued) ) {
+                    if ( mpool->schedule(this, mworker) )
+                        return true;
+                    mstate = Idle;
+                    return false;
+                }
+                break;
+            case Running:
+                // the worker queues us again when loop() returns.
+                if ( os::CAS(&mstate, (int)Running, (int)Retriggered) )
+                    return true;
+                break;
+            default:
+                // already queued.
+                return true;
+            }
+        }
+    }
+
+    void ThreadPoolActivity::work(os::ThreadInterface* worker, unsigned int index)
+    {
+        if ( !active ) {
+            mstate = Idle;
+            return;
+        }
+        mstate = Running;
+        mworker = index;
+        mcurrent = worker;
+        if (runner)
+            runner->loop();
+        mcurrent = 0;
+        if ( os::CAS(&mstate, (int)Running, (int)Idle) )
+            return;
+        // triggered while running: queue again, on this worker.
+        mstate = Queued;
+        if ( !active || !mpool->schedule(this, index) )
+            mstate = Idle;
+    }
+}
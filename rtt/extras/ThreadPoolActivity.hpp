@@ -0,0 +1,141 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  ThreadPoolActivity.hpp
+
+                        ThreadPoolActivity.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_THREAD_POOL_ACTIVITY_HPP
+#define ORO_THREAD_POOL_ACTIVITY_HPP
+
+#include "../base/ActivityInterface.hpp"
+#include "../base/RunnableInterface.hpp"
+#include "ThreadPool.hpp"
+
+namespace RTT
+{ namespace extras {
+
+    /**
+     * @brief A non periodic activity which is executed by one of the
+     * worker threads of a ThreadPool, instead of by a thread of its own.
+     *
+     * Use it like any other activity, for example with
+     * TaskContext::setActivity(). Many ThreadPoolActivity objects can share
+     * a pool with a few workers, and one activity never executes on two
+     * workers at the same time.
+     *
+     * A worker that is blocked, for example in a call to an operation of
+     * another component of the same pool, can not execute other
+     * activities. Such a call deadlocks if no other worker is left to
+     * execute the called component, so create pools with more workers
+     * than the depth of such calls.
+     *
+     * \section ExecReact Reactions to execute():
+     * Always returns false.
+     *
+     * \section TrigReact Reactions to trigger():
+     * Queues this activity in the pool, such that a worker executes
+     * base::RunnableInterface::loop() once. Triggers that arrive while this
+     * activity is queued are merged, a trigger that arrives while it
+     * executes queues it again.
+     *
+     * @ingroup CoreLibActivities
+     */
+    class RTT_API ThreadPoolActivity
+        : public base::ActivityInterface
+    {
+    public:
+        /**
+         * Creates an activity which is executed by the workers of \a pool.
+         * @param pool The pool to use.
+         * @param run Run this instance.
+         */
+        ThreadPoolActivity( ThreadPool::shared_ptr pool, base::RunnableInterface* run = 0 );
+
+        /**
+         * Stops the activity and waits until no worker uses it.
+         */
+        ~ThreadPoolActivity();
+
+        ThreadPool::shared_ptr getPool() const;
+
+        Seconds getPeriod() const;
+
+        bool setPeriod(Seconds s);
+
+        unsigned getCpuAffinity() const;
+
+        bool setCpuAffinity(unsigned cpu);
+
+        /**
+         * Returns the worker that is executing this activity, or a
+         * placeholder thread of the pool if none is.
+         */
+        os::ThreadInterface* thread();
+
+        bool start();
+
+        bool stop();
+
+        bool isRunning() const;
+
+        bool isPeriodic() const;
+
+        bool isActive() const;
+
+        bool execute();
+
+        bool trigger();
+
+    private:
+        friend class ThreadPool;
+
+        /**
+         * Executes this activity once in \a worker, which took it
+         * from the queue of the pool.
+         */
+        void work(os::ThreadInterface* worker, unsigned int index);
+
+        enum { Idle, Queued, Running, Retriggered };
+
+        ThreadPool::shared_ptr mpool;
+        bool mattached;
+        volatile bool active;
+        volatile int mstate;
+        os::ThreadInterface* volatile mcurrent;
+        unsigned int mworker;
+    };
+
+}}
+
+#endif
@@ -3,13 +3,18 @@
 
 namespace RTT {
     namespace extras {
+        class ActivityGroup;
+        class DataFlowActivity;
         class FileDescriptorActivity;
+        class GroupActivity;
         class IRQActivity;
         class PeriodicActivity;
         class SequentialActivity;
         class SimulationActivity;
         class SimulationThread;
         class SlaveActivity;
+        class ThreadPool;
+        class ThreadPoolActivity;
         class TimerThread;
         struct Provider;
         struct RT_INTR;
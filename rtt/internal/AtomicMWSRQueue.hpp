@@ -59,7 +59,7 @@ namespace RTT
         class AtomicMWSRQueue
         {
             //typedef _T* T;
-            const int _size;
+            const unsigned int _size;
             typedef T C;
             typedef volatile C* CachePtrType;
             typedef C* volatile CacheObjType;
@@ -75,8 +75,8 @@ namespace RTT
              */
             union SIndexes
             {
-                unsigned long _value;
-                unsigned short _index[2];
+                unsigned long long _value;
+                unsigned int _index[2];
             };
 
             /**
@@ -217,8 +217,7 @@ namespace RTT
             {
                 SIndexes val;
                 val._value = _indxes._value;
-                int c = (val._index[0] - val._index[1]);
-                return c >= 0 ? c : c + _size;
+                return val._index[0] >= val._index[1] ? val._index[0] - val._index[1] : val._index[0] + _size - val._index[1];
             }
 
             /**
@@ -237,6 +236,37 @@ namespace RTT
                 return true;
             }
 
+            /**
+             * Enqueue a series of items. The room for all items that fit
+             * in the queue is reserved at once, such that the items of
+             * one call are never interleaved with those of other writers.
+             * @param values Points to \a n values to enqueue, none of which may be null.
+             * @param n The number of values to enqueue.
+             * @return The number of values that were queued, starting from the first.
+             */
+            size_type enqueue(const T* values, size_type n)
+            {
+                SIndexes oldval, newval;
+                size_type count;
+                do
+                {
+                    oldval._value = _indxes._value;
+                    newval._value = oldval._value;
+                    size_type used = oldval._index[0] >= oldval._index[1] ? oldval._index[0] - oldval._index[1] : oldval._index[0] + _size - oldval._index[1];
+                    count = (_size - 1) - used;
+                    if (n < count)
+                        count = n;
+                    if (count == 0)
+                        return 0;
+                    newval._index[0] = (oldval._index[0] + count) % _size;
+                } while (!os::CAS(&_indxes._value, oldval._value, newval._value));
+                // the reader stops at the first slot that is not yet written,
+                // so the reserved slots may be filled in in order.
+                for (size_type i = 0; i != count; ++i)
+                    _buf[(oldval._index[0] + i) % _size] = values[i];
+                return count;
+            }
+
             /**
              * Dequeue an item.
              * @param value Stores the dequeued value. It is unchanged when
@@ -267,7 +297,7 @@ namespace RTT
              */
             void clear()
             {
-                for (int i = 0; i != _size; ++i)
+                for (unsigned int i = 0; i != _size; ++i)
                 {
                     _buf[i] = 0;
                 }
@@ -41,6 +41,7 @@
 
 #include "../base/ChannelElement.hpp"
 #include "../base/BufferInterface.hpp"
+#include "SharedSample.hpp"
 
 namespace RTT { namespace internal {
 
@@ -65,6 +66,30 @@ namespace RTT { namespace internal {
         typedef typename base::ChannelElement<T>::reference_t reference_t;
 	typedef typename base::ChannelElement<T>::value_t value_t;
 
+    private:
+        /** Makes \a new_sample_p the last read sample, if it is not null,
+         * and copies the last read sample into \a sample.
+         */
+        FlowStatus update(value_t *new_sample_p, reference_t sample, bool copy_old_data)
+        {
+            if ( new_sample_p ) {
+		if(last_sample_p)
+		    buffer->Release(last_sample_p);
+		
+		last_sample_p = new_sample_p;
+		sample = *new_sample_p;
+                return NewData;
+            }
+            if (last_sample_p) {
+		if(copy_old_data)
+		    sample = *(last_sample_p);
+                return OldData;
+            }
+            return NoData;
+        }
+
+    public:
+
         ChannelBufferElement(typename base::BufferInterface<T>::shared_ptr buffer)
             : buffer(buffer), last_sample_p(0) {}
             
@@ -100,27 +125,52 @@ namespace RTT { namespace internal {
             return true;
         }
 
+        /** Appends a batch of samples at the end of the FIFO and
+         * signals the reader once.
+         *
+         * @return true, samples that did not fit in the FIFO are dropped.
+         */
+        virtual bool writeBatch(std::vector<value_t> const& samples)
+        {
+            if (buffer->Push(samples) != 0)
+                return this->signal();
+            return true;
+        }
+
         /** Pops and returns the first element of the FIFO
          *
          * @return false if the FIFO was empty, and true otherwise
          */
         virtual FlowStatus read(reference_t sample, bool copy_old_data)
         {
-	    value_t *new_sample_p;
-            if ( (new_sample_p = buffer->PopWithoutRelease()) ) {
-		if(last_sample_p)
-		    buffer->Release(last_sample_p);
-		
-		last_sample_p = new_sample_p;
-		sample = *new_sample_p;
-                return NewData;
-            }
-            if (last_sample_p) {
-		if(copy_old_data)
-		    sample = *(last_sample_p);
-                return OldData;
+            return update(buffer->PopWithoutRelease(), sample, copy_old_data);
+        }
+
+        /** Pops all elements of the FIFO and appends them to \a samples.
+         * The last popped element is kept as old data for read().
+         */
+        virtual FlowStatus readBatch(std::vector<value_t>& samples)
+        {
+            value_t *new_sample_p;
+            bool popped = false;
+            while ( (new_sample_p = buffer->PopWithoutRelease()) ) {
+                if(last_sample_p)
+                    buffer->Release(last_sample_p);
+                last_sample_p = new_sample_p;
+                samples.push_back(*new_sample_p);
+                popped = true;
             }
-            return NoData;
+            if (popped)
+                return NewData;
+            return last_sample_p ? OldData : NoData;
+        }
+
+        /** Pops all elements of the FIFO and returns the last one. The
+         * other elements are dropped without being copied.
+         */
+        virtual FlowStatus readNewest(reference_t sample, bool copy_old_data)
+        {
+            return update(buffer->PopNewestWithoutRelease(), sample, copy_old_data);
         }
 
         /** Removes all elements in the FIFO. After a call to clear(), read()
@@ -152,6 +202,136 @@ namespace RTT { namespace internal {
             return "ChannelBufferElement";
         }
     };
+
+    /** A connection element that can store a fixed number of shared
+     * samples. All connections of an OutputPort in shared sample mode refer
+     * to the same written samples, which are only copied when read() is used.
+     */
+    template<typename T>
+    class ChannelSharedBufferElement : public base::ChannelElement<T>, public ChannelBufferElementBase
+    {
+    public:
+        typedef typename base::ChannelElement<T>::param_t param_t;
+        typedef typename base::ChannelElement<T>::reference_t reference_t;
+        typedef typename base::ChannelElement<T>::sample_ptr sample_ptr;
+
+    private:
+        typename base::BufferInterface<sample_ptr>::shared_ptr buffer;
+        typename SharedSamplePool<T>::shared_ptr pool;
+        sample_ptr last_sample;
+
+    public:
+        ChannelSharedBufferElement(typename base::BufferInterface<sample_ptr>::shared_ptr buffer,
+                                   typename SharedSamplePool<T>::shared_ptr pool)
+            : buffer(buffer), pool(pool) {}
+
+        virtual size_t getBufferSize() const
+        {
+            return buffer->capacity();
+        }
+
+        virtual size_t getBufferFillSize() const
+        {
+            return buffer->size();
+        }
+
+        virtual size_t getNumDroppedSamples() const
+        {
+            return buffer->dropped();
+        }
+
+        /** Appends a shared sample at the end of the FIFO
+         *
+         * @return true if there was room in the FIFO for the new sample, and false otherwise.
+         */
+        virtual bool writeShared(sample_ptr const& sample)
+        {
+            if (buffer->Push(sample))
+                return this->signal();
+            return true;
+        }
+
+        /** Wraps \a sample in a new shared sample and appends it. */
+        virtual bool write(param_t sample)
+        {
+            return writeShared( pool->allocate(sample) );
+        }
+
+        /** Wraps each sample of the batch in a new shared sample, appends
+         * them and signals the reader once. */
+        virtual bool writeBatch(std::vector<T> const& samples)
+        {
+            bool pushed = false;
+            typename std::vector<T>::const_iterator it;
+            for (it = samples.begin(); it != samples.end(); ++it)
+                pushed = buffer->Push( pool->allocate(*it) ) || pushed;
+            if (pushed)
+                return this->signal();
+            return true;
+        }
+
+        virtual FlowStatus readShared(sample_ptr& sample, bool copy_old_data)
+        {
+            sample_ptr *new_sample_p;
+            if ( (new_sample_p = buffer->PopWithoutRelease()) ) {
+                last_sample = *new_sample_p;
+                // don't keep a reference in the free buffer slot.
+                *new_sample_p = sample_ptr();
+                buffer->Release(new_sample_p);
+                sample = last_sample;
+                return NewData;
+            }
+            if (last_sample) {
+                if(copy_old_data)
+                    sample = last_sample;
+                return OldData;
+            }
+            return NoData;
+        }
+
+        /** Pops all shared samples of the FIFO and copies the data
+         * of the last one into \a sample.
+         */
+        virtual FlowStatus readNewest(reference_t sample, bool copy_old_data)
+        {
+            sample_ptr shared;
+            FlowStatus result = readShared(shared, copy_old_data);
+            if (result == NewData)
+                while (readShared(shared, false) == NewData);
+            if (shared && (result == NewData || copy_old_data))
+                sample = shared->get();
+            return result;
+        }
+
+        /** Pops the first shared sample of the FIFO and copies its
+         * data into \a sample.
+         */
+        virtual FlowStatus read(reference_t sample, bool copy_old_data)
+        {
+            sample_ptr shared;
+            FlowStatus result = readShared(shared, copy_old_data);
+            if (shared)
+                sample = shared->get();
+            return result;
+        }
+
+        virtual void clear()
+        {
+            last_sample = sample_ptr();
+            buffer->clear();
+            base::ChannelElement<T>::clear();
+        }
+
+        virtual T data_sample()
+        {
+            return pool->data_sample();
+        }
+
+        virtual std::string getElementName() const
+        {
+            return "ChannelSharedBufferElement";
+        }
+    };
 }}
 
 #endif
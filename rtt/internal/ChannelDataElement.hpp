@@ -41,6 +41,7 @@
 
 #include "../base/ChannelElement.hpp"
 #include "../base/DataObjectInterface.hpp"
+#include "SharedSample.hpp"
 
 namespace RTT { namespace internal {
 
@@ -69,6 +70,14 @@ namespace RTT { namespace internal {
             return this->signal();
         }
 
+        /** Only the last sample of a batch is kept in a data connection. */
+        virtual bool writeBatch(std::vector<T> const& samples)
+        {
+            if (samples.empty())
+                return true;
+            return write(samples.back());
+        }
+
         /** Reads the last sample given to write()
          *
          * @return false if no sample has ever been written, true otherwise
@@ -117,6 +126,100 @@ namespace RTT { namespace internal {
             return "ChannelDataElement";
         };
     };
+
+    /** A connection element that stores a single shared sample. All
+     * connections of an OutputPort in shared sample mode refer to the
+     * same written sample, which is only copied when read() is used.
+     */
+    template<typename T>
+    class ChannelSharedDataElement : public base::ChannelElement<T>
+    {
+    public:
+        typedef typename base::ChannelElement<T>::param_t param_t;
+        typedef typename base::ChannelElement<T>::reference_t reference_t;
+        typedef typename base::ChannelElement<T>::sample_ptr sample_ptr;
+
+    private:
+        bool written, mread;
+        typename base::DataObjectInterface<sample_ptr>::shared_ptr data;
+        typename SharedSamplePool<T>::shared_ptr pool;
+
+    public:
+        ChannelSharedDataElement(typename base::DataObjectInterface<sample_ptr>::shared_ptr storage,
+                                 typename SharedSamplePool<T>::shared_ptr pool)
+            : written(false), mread(false), data(storage), pool(pool) {}
+
+        /** Update the shared sample stored in this element.
+         * It always returns true. */
+        virtual bool writeShared(sample_ptr const& sample)
+        {
+            data->Set(sample);
+            written = true;
+            mread = false;
+            return this->signal();
+        }
+
+        /** Wraps \a sample in a new shared sample and stores it. */
+        virtual bool write(param_t sample)
+        {
+            return writeShared( pool->allocate(sample) );
+        }
+
+        /** Only the last sample of a batch is kept in a data connection. */
+        virtual bool writeBatch(std::vector<T> const& samples)
+        {
+            if (samples.empty())
+                return true;
+            return write(samples.back());
+        }
+
+        virtual FlowStatus readShared(sample_ptr& sample, bool copy_old_data)
+        {
+            if (written)
+            {
+                if ( !mread ) {
+                    data->Get(sample);
+                    mread = true;
+                    return NewData;
+                }
+
+                if(copy_old_data)
+                    data->Get(sample);
+
+                return OldData;
+            }
+            return NoData;
+        }
+
+        /** Reads the last sample given to write() or writeShared()
+         * and copies its data into \a sample.
+         */
+        virtual FlowStatus read(reference_t sample, bool copy_old_data)
+        {
+            sample_ptr shared;
+            FlowStatus result = readShared(shared, copy_old_data);
+            if (shared)
+                sample = shared->get();
+            return result;
+        }
+
+        virtual void clear()
+        {
+            written = false;
+            mread = false;
+            base::ChannelElement<T>::clear();
+        }
+
+        virtual T data_sample()
+        {
+            return pool->data_sample();
+        }
+
+        virtual std::string getElementName() const
+        {
+            return "ChannelSharedDataElement";
+        };
+    };
 }}
 
 #endif
@@ -0,0 +1,84 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  Completion.cpp
+
+                        Completion.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "Completion.hpp"
+#include "../os/Semaphore.hpp"
+#include "../os/CAS.hpp"
+
+namespace RTT
+{ namespace internal {
+
+    struct Completion::Waiter
+    {
+        os::Semaphore sem;
+        Waiter() : sem(0) {}
+    };
+
+    Completion::Waiter* Completion::completed()
+    {
+        static char tag;
+        return reinterpret_cast<Waiter*>(&tag);
+    }
+
+    void Completion::complete()
+    {
+        Waiter* w;
+        do {
+            w = mwaiter;
+        } while ( !os::CAS(&mwaiter, w, completed()) );
+        if ( w && w != completed() )
+            w->sem.signal();
+    }
+
+    bool Completion::isComplete() const
+    {
+        return mwaiter == completed();
+    }
+
+    bool Completion::wait()
+    {
+        if ( mwaiter == completed() )
+            return true;
+        Waiter w;
+        if ( os::CAS(&mwaiter, (Waiter*)0, &w) ) {
+            w.sem.wait();
+            return true;
+        }
+        // completed in the mean time, or another thread is waiting.
+        return mwaiter == completed();
+    }
+}}
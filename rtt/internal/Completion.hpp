@@ -0,0 +1,93 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  Completion.hpp
+
+                        Completion.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_COMPLETION_HPP
+#define ORO_COMPLETION_HPP
+
+#include "../rtt-config.h"
+
+namespace RTT
+{ namespace internal {
+
+    /**
+     * Wakes up the one thread waiting for the completion of a
+     * single request, instead of all threads waiting on an
+     * ExecutionEngine.
+     *
+     * The thread executing the request calls complete(), which does
+     * not take a lock and only signals the waiting thread, if any.
+     * The waiting thread blocks on a semaphore it creates on its own
+     * stack, so a wait() may not be done in a hard real-time thread.
+     */
+    class RTT_API Completion
+    {
+    public:
+        Completion() : mwaiter(0) {}
+
+        /**
+         * A copy is not completed and has no waiter.
+         */
+        Completion(const Completion&) : mwaiter(0) {}
+
+        Completion& operator=(const Completion&) { return *this; }
+
+        /**
+         * Marks the request as completed and wakes up the waiting thread.
+         */
+        void complete();
+
+        bool isComplete() const;
+
+        /**
+         * Blocks until complete() was called.
+         * @return false if another thread is already waiting on
+         * this object, in which case this function returns immediately.
+         */
+        bool wait();
+
+    private:
+        struct Waiter;
+        static Waiter* completed();
+
+        /**
+         * Null, the waiting thread or completed().
+         */
+        Waiter* volatile mwaiter;
+    };
+}}
+
+#endif
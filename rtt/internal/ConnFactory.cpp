@@ -70,6 +70,18 @@ ConnID* StreamConnID::clone() const {
     return new StreamConnID(this->name_id);
 }
 
+unsigned int ConnFactory::sharedSampleCapacity(ConnPolicy const& policy)
+{
+    if (policy.type == ConnPolicy::DATA) {
+        // the slots of the data object, plus the sample held by the reader.
+        unsigned int slots = policy.lock_policy == ConnPolicy::LOCK_FREE || policy.lock_policy == ConnPolicy::SPSC ? 4 : 1;
+        return slots + 1;
+    }
+    // the buffer and its spare slot, the last read sample and
+    // the sample held by the reader.
+    return policy.size + 3;
+}
+
 base::ChannelElementBase::shared_ptr RTT::internal::ConnFactory::createRemoteConnection(base::OutputPortInterface& output_port, base::InputPortInterface& input_port, const ConnPolicy& policy)
 {
     // Remote connection
@@ -53,6 +53,7 @@
 #include "../base/Buffer.hpp"
 #include "../base/BufferUnSync.hpp"
 #include "../Logger.hpp"
+#include <boost/type_traits/is_pod.hpp>
 
 namespace RTT
 { namespace internal {
@@ -128,6 +129,109 @@ namespace RTT
          */
         virtual base::ChannelElementBase::shared_ptr buildChannelInput(base::OutputPortInterface& port) const = 0;
 
+#ifndef OROBLD_OS_NO_ASM
+        /**
+         * Creates the lock free data object for a plain old data type.
+         * A DataObjectSeqLock never drops a sample, whatever the number
+         * of readers.
+         */
+        template<typename T>
+        static base::DataObjectInterface<T>* buildLockFreeDataObject(const T& initial_value, boost::true_type)
+        {
+            return new base::DataObjectSeqLock<T>(initial_value);
+        }
+
+        /**
+         * Creates the lock free data object for any other type.
+         */
+        template<typename T>
+        static base::DataObjectInterface<T>* buildLockFreeDataObject(const T& initial_value, boost::false_type)
+        {
+            return new base::DataObjectLockFree<T>(initial_value);
+        }
+#endif
+
+        /**
+         * Creates the data object that stores the sample of a DATA connection,
+         * according to the lock policy in \a policy. Lock free connections of
+         * plain old data types are protected by a sequence lock.
+         */
+        template<typename T>
+        static typename base::DataObjectInterface<T>::shared_ptr buildDataObject(ConnPolicy const& policy, const T& initial_value = T())
+        {
+            typename base::DataObjectInterface<T>::shared_ptr data_object;
+            switch (policy.lock_policy)
+            {
+#ifndef OROBLD_OS_NO_ASM
+            case ConnPolicy::SPSC:
+            case ConnPolicy::LOCK_FREE:
+                data_object.reset( buildLockFreeDataObject<T>(initial_value, boost::is_pod<T>()) );
+                break;
+#else
+            case ConnPolicy::SPSC:
+            case ConnPolicy::LOCK_FREE:
+                RTT::log(Warning) << "lock free connection policy is unavailable on this system, defaulting to LOCKED" << RTT::endlog();
+#endif
+            case ConnPolicy::LOCKED:
+                data_object.reset( new base::DataObjectLocked<T>(initial_value) );
+                break;
+            case ConnPolicy::UNSYNC:
+                data_object.reset( new base::DataObjectUnSync<T>(initial_value) );
+                break;
+            }
+            return data_object;
+        }
+
+        /**
+         * Creates the buffer that stores the samples of a BUFFER or CIRCULAR_BUFFER
+         * connection, according to the lock policy and size in \a policy.
+         * A SPSC BUFFER uses a wait-free ring buffer, a SPSC CIRCULAR_BUFFER
+         * is lock free since the writer needs to drop old samples.
+         * @return a null pointer if no buffer of the requested size can be created.
+         */
+        template<typename T>
+        static typename base::BufferInterface<T>::shared_ptr buildBuffer(ConnPolicy const& policy, const T& initial_value = T())
+        {
+            base::BufferInterface<T>* buffer_object = 0;
+            if (policy.size < 0) {
+                RTT::log(Error) << "Can not create a buffer of size " << policy.size << ": the size of a buffer connection can not be negative." << RTT::endlog();
+                return typename base::BufferInterface<T>::shared_ptr();
+            }
+#ifndef ORO_EMBEDDED
+            try {
+#endif
+            switch (policy.lock_policy)
+            {
+#ifndef OROBLD_OS_NO_ASM
+            case ConnPolicy::SPSC:
+                if (policy.type != ConnPolicy::CIRCULAR_BUFFER) {
+                    buffer_object = new base::BufferSPSC<T>(policy.size, initial_value);
+                    break;
+                }
+            case ConnPolicy::LOCK_FREE:
+                buffer_object = new base::BufferLockFree<T>(policy.size, initial_value, policy.type == ConnPolicy::CIRCULAR_BUFFER);
+                break;
+#else
+            case ConnPolicy::SPSC:
+            case ConnPolicy::LOCK_FREE:
+                RTT::log(Warning) << "lock free connection policy is unavailable on this system, defaulting to LOCKED" << RTT::endlog();
+#endif
+            case ConnPolicy::LOCKED:
+                buffer_object = new base::BufferLocked<T>(policy.size, initial_value, policy.type == ConnPolicy::CIRCULAR_BUFFER);
+                break;
+            case ConnPolicy::UNSYNC:
+                buffer_object = new base::BufferUnSync<T>(policy.size, initial_value, policy.type == ConnPolicy::CIRCULAR_BUFFER);
+                break;
+            }
+#ifndef ORO_EMBEDDED
+            } catch (std::bad_alloc&) {
+                RTT::log(Error) << "Can not create a buffer of size " << policy.size << ": out of memory." << RTT::endlog();
+                return typename base::BufferInterface<T>::shared_ptr();
+            }
+#endif
+            return typename base::BufferInterface<T>::shared_ptr(buffer_object);
+        }
+
         /** This method creates the connection element that will store data
          * inside the connection, based on the given policy
          * @todo: shouldn't this belong in the template type info ? This allows the type lib to
@@ -140,53 +244,51 @@ namespace RTT
         {
             if (policy.type == ConnPolicy::DATA)
             {
-                typename base::DataObjectInterface<T>::shared_ptr data_object;
-                switch (policy.lock_policy)
-                {
-#ifndef OROBLD_OS_NO_ASM
-                case ConnPolicy::LOCK_FREE:
-                    data_object.reset( new base::DataObjectLockFree<T>(initial_value) );
-                    break;
-#else
-		case ConnPolicy::LOCK_FREE:
-		    RTT::log(Warning) << "lock free connection policy is unavailable on this system, defaulting to LOCKED" << RTT::endlog();
-#endif
-                case ConnPolicy::LOCKED:
-                    data_object.reset( new base::DataObjectLocked<T>(initial_value) );
-                    break;
-                case ConnPolicy::UNSYNC:
-                    data_object.reset( new base::DataObjectUnSync<T>(initial_value) );
-                    break;
-                }
+                return new ChannelDataElement<T>( buildDataObject<T>(policy, initial_value) );
+            }
+            else if (policy.type == ConnPolicy::BUFFER || policy.type == ConnPolicy::CIRCULAR_BUFFER)
+            {
+                typename base::BufferInterface<T>::shared_ptr buffer = buildBuffer<T>(policy, initial_value);
+                if (!buffer)
+                    return NULL;
+                return new ChannelBufferElement<T>( buffer );
+            }
+            return NULL;
+        }
 
-                ChannelDataElement<T>* result = new ChannelDataElement<T>(data_object);
-                return result;
+        /**
+         * Creates the connection element that stores shared samples inside
+         * the connection, based on the given policy.
+         * @param policy The policy dictating which kind of storage must be created.
+         * @param pool The pool of the OutputPort in shared sample mode that will
+         * write to this connection.
+         * @see OutputPort::shareSamples()
+         */
+        template<typename T>
+        static base::ChannelElementBase* buildSharedDataStorage(ConnPolicy const& policy, typename SharedSamplePool<T>::shared_ptr pool)
+        {
+            typedef typename SharedSample<T>::shared_ptr sample_ptr;
+            if (policy.type == ConnPolicy::DATA)
+            {
+                return new ChannelSharedDataElement<T>( buildDataObject<sample_ptr>(policy), pool );
             }
             else if (policy.type == ConnPolicy::BUFFER || policy.type == ConnPolicy::CIRCULAR_BUFFER)
             {
-                base::BufferInterface<T>* buffer_object = 0;
-                switch (policy.lock_policy)
-                {
-#ifndef OROBLD_OS_NO_ASM
-                case ConnPolicy::LOCK_FREE:
-                    buffer_object = new base::BufferLockFree<T>(policy.size, initial_value, policy.type == ConnPolicy::CIRCULAR_BUFFER);
-                    break;
-#else
-		case ConnPolicy::LOCK_FREE:
-		    RTT::log(Warning) << "lock free connection policy is unavailable on this system, defaulting to LOCKED" << RTT::endlog();
-#endif
-                case ConnPolicy::LOCKED:
-                    buffer_object = new base::BufferLocked<T>(policy.size, initial_value, policy.type == ConnPolicy::CIRCULAR_BUFFER);
-                    break;
-                case ConnPolicy::UNSYNC:
-                    buffer_object = new base::BufferUnSync<T>(policy.size, initial_value, policy.type == ConnPolicy::CIRCULAR_BUFFER);
-                    break;
-                }
-                return new ChannelBufferElement<T>(typename base::BufferInterface<T>::shared_ptr(buffer_object));
+                typename base::BufferInterface<sample_ptr>::shared_ptr buffer = buildBuffer<sample_ptr>(policy);
+                if (!buffer)
+                    return NULL;
+                return new ChannelSharedBufferElement<T>( buffer, pool );
             }
             return NULL;
         }
 
+        /**
+         * Returns the number of shared samples a connection with the given policy
+         * can hold at the same time. An OutputPort in shared sample mode
+         * reserves this number of samples in its pool for each connection.
+         */
+        static unsigned int sharedSampleCapacity(ConnPolicy const& policy);
+
         /** During the process of building a connection between two ports, this
          * method builds the input half (starting from the OutputPort).
          *
@@ -221,6 +323,8 @@ namespace RTT
             assert(conn_id);
             base::ChannelElementBase::shared_ptr endpoint = new ConnInputEndpoint<T>(&port, conn_id);
             base::ChannelElementBase::shared_ptr data_object = buildDataStorage<T>(policy, port.getLastWrittenValue() );
+            if (!data_object)
+                return base::ChannelElementBase::shared_ptr();
             endpoint->setOutput(data_object);
             if (output_channel)
                 data_object->setOutput(output_channel);
@@ -257,6 +361,28 @@ namespace RTT
             assert(conn_id);
             base::ChannelElementBase::shared_ptr endpoint = new ConnOutputEndpoint<T>(&port, conn_id);
             base::ChannelElementBase::shared_ptr data_object = buildDataStorage<T>(policy, initial_value);
+            if (!data_object)
+                return base::ChannelElementBase::shared_ptr();
+            data_object->setOutput(endpoint);
+            return data_object;
+        }
+
+        /**
+         * Variant of buildBufferedChannelOutput that installs a storage for
+         * shared samples before the channel output endpoint.
+         * @param port The input port to which the connection is added.
+         * @param conn_id A unique connection id which identifies this connection
+         * @param policy The policy dictating which kind of storage must be installed.
+         * @param pool The pool of the OutputPort in shared sample mode.
+         */
+        template<typename T>
+        static base::ChannelElementBase::shared_ptr buildSharedChannelOutput(InputPort<T>& port, ConnID* conn_id, ConnPolicy const& policy, typename SharedSamplePool<T>::shared_ptr pool)
+        {
+            assert(conn_id);
+            base::ChannelElementBase::shared_ptr endpoint = new ConnOutputEndpoint<T>(&port, conn_id);
+            base::ChannelElementBase::shared_ptr data_object = buildSharedDataStorage<T>(policy, pool);
+            if (!data_object)
+                return base::ChannelElementBase::shared_ptr();
             data_object->setOutput(endpoint);
             return data_object;
         }
@@ -291,7 +417,10 @@ namespace RTT
                     return false;
                 }
                 // local ports, create buffer here.
-                output_half = buildBufferedChannelOutput<T>(*input_p, output_port.getPortID(), policy, output_port.getLastWrittenValue());
+                if ( output_port.sharesSamples() )
+                    output_half = buildSharedChannelOutput<T>(*input_p, output_port.getPortID(), policy, output_port.getSharedSamplePool());
+                else
+                    output_half = buildBufferedChannelOutput<T>(*input_p, output_port.getPortID(), policy, output_port.getLastWrittenValue());
             }
             else
             {
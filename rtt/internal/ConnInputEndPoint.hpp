@@ -75,6 +75,25 @@ namespace RTT
             return true;
         }
 
+        /** Passes a shared sample on to the next element, without
+         * copying its data. */
+        virtual bool writeShared(typename base::ChannelElement<T>::sample_ptr const& sample)
+        {
+            typename base::ChannelElement<T>::shared_ptr output = this->getOutput();
+            if (output)
+                return output->writeShared(sample);
+            return false;
+        }
+
+        /** Passes a batch of samples on to the next element at once. */
+        virtual bool writeBatch(std::vector<T> const& samples)
+        {
+            typename base::ChannelElement<T>::shared_ptr output = this->getOutput();
+            if (output)
+                return output->writeBatch(samples);
+            return false;
+        }
+
         virtual void disconnect(bool forward)
         {
             // Call the base class first
@@ -97,6 +97,26 @@ namespace RTT
         virtual bool write(typename base::ChannelElement<T>::param_t sample)
         { return false; }
 
+        /** Reads the newest sample from the element that stores
+         * the samples of this connection. */
+        virtual FlowStatus readNewest(typename base::ChannelElement<T>::reference_t sample, bool copy_old_data)
+        {
+            typename base::ChannelElement<T>::shared_ptr input = this->getInput();
+            if (input)
+                return input->readNewest(sample, copy_old_data);
+            return NoData;
+        }
+
+        /** Reads all new samples from the element that stores
+         * the samples of this connection. */
+        virtual FlowStatus readBatch(std::vector<T>& samples)
+        {
+            typename base::ChannelElement<T>::shared_ptr input = this->getInput();
+            if (input)
+                return input->readBatch(samples);
+            return NoData;
+        }
+
         virtual void disconnect(bool forward)
         {
             // Call the base class: it does the common cleanup
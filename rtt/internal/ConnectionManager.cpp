@@ -48,6 +48,7 @@
 #include <boost/scoped_ptr.hpp>
 #include "../base/PortInterface.hpp"
 #include "../os/MutexLock.hpp"
+#include "../os/fosi.h"
 #include "../base/InputPortInterface.hpp"
 #include <cassert>
 
@@ -58,8 +59,37 @@ namespace RTT
     namespace internal
     {
 
+        ConnectionManager::Snapshot::Snapshot()
+        {
+            ORO_ATOMIC_SETUP(&readers, 0);
+        }
+
+        ConnectionManager::Snapshot::~Snapshot()
+        {
+            ORO_ATOMIC_CLEANUP(&readers);
+        }
+
+        ConnectionManager::SnapshotReference::SnapshotReference(const ConnectionManager* manager)
+        {
+            // A reference is only valid if the snapshot was still active after
+            // taking it. Otherwise, publish() may already be waiting for it.
+            while (true) {
+                msnapshot = manager->active;
+                oro_atomic_inc( &msnapshot->readers );
+                if ( msnapshot == manager->active )
+                    return;
+                oro_atomic_dec( &msnapshot->readers );
+            }
+        }
+
+        ConnectionManager::SnapshotReference::~SnapshotReference()
+        {
+            oro_atomic_dec( &msnapshot->readers );
+        }
+
         ConnectionManager::ConnectionManager(PortInterface* port)
             : mport(port)
+            , active(&snapshots[0])
             , cur_channel(NULL)
         {
         }
@@ -78,8 +108,28 @@ namespace RTT
         }
 
         void ConnectionManager::clear()
-        { RTT::os::MutexLock lock(connection_lock);
-            std::for_each(connections.begin(), connections.end(), &clearChannel);
+        { SnapshotReference snapshot(this);
+            std::for_each(snapshot->connections.begin(), snapshot->connections.end(), &clearChannel);
+        }
+
+        void ConnectionManager::publish(Connections& connections)
+        {
+            Snapshot* previous = active;
+            Snapshot* next = (previous == &snapshots[0]) ? &snapshots[1] : &snapshots[0];
+            // next is unused: it was emptied when it was replaced.
+            next->connections.swap(connections);
+            os::CAS(&active, previous, next);
+
+            // wait until all readers of the previous snapshot are gone.
+            TIME_SPEC ts;
+            ts.tv_sec = 0;
+            ts.tv_nsec = 1000;
+            while ( oro_atomic_read(&previous->readers) != 0 )
+                rtos_nanosleep(&ts, NULL);
+            // hand the previous descriptors to the caller, for cleanup
+            // outside of the lock.
+            connections.clear();
+            connections.swap(previous->connections);
         }
 
         bool ConnectionManager::findMatchingPort(ConnID const* conn_id, ChannelDescriptor const& descriptor)
@@ -87,12 +137,15 @@ namespace RTT
             return ( descriptor.get<0>() && conn_id->isSameID(*descriptor.get<0>()));
         }
 
-        void ConnectionManager::updateCurrentChannel(bool reset_current)
+        ConnectionManager::ChannelDescriptor* ConnectionManager::findCurrentChannel(Snapshot& snapshot) const
         {
-            if (connections.empty())
-                cur_channel = NULL;
-            else if (reset_current)
-                cur_channel = &(connections.front());
+            if ( snapshot.connections.empty() )
+                return NULL;
+            base::ChannelElementBase* current = cur_channel;
+            for (Connections::iterator it = snapshot.connections.begin(); it != snapshot.connections.end(); ++it)
+                if ( it->get<1>().get() == current )
+                    return &(*it);
+            return &(snapshot.connections.front());
         }
 
         bool ConnectionManager::disconnect(PortInterface* port)
@@ -112,11 +165,25 @@ namespace RTT
             return true;
         }
 
+        void ConnectionManager::eraseChannel(ChannelElementBase::shared_ptr channel)
+        {
+            Connections connections;
+            { RTT::os::MutexLock lock(connection_lock);
+                Connections const& current = active->connections;
+                for (Connections::const_iterator it = current.begin(); it != current.end(); ++it)
+                    if ( it->get<1>() != channel )
+                        connections.push_back(*it);
+                if ( connections.size() == current.size() )
+                    return;
+                publish(connections);
+            }
+        }
+
         void ConnectionManager::disconnect()
         {
-            std::list<ChannelDescriptor> all_connections;
+            Connections all_connections;
             { RTT::os::MutexLock lock(connection_lock);
-                all_connections.splice(all_connections.end(), connections);
+                publish(all_connections);
                 cur_channel = NULL;
             }
             std::for_each(all_connections.begin(), all_connections.end(),
@@ -124,32 +191,53 @@ namespace RTT
         }
 
         bool ConnectionManager::connected() const
-        { return !connections.empty(); }
+        { SnapshotReference snapshot(this);
+            return !snapshot->connections.empty();
+        }
 
+        bool ConnectionManager::isSingleConnection() const
+        { SnapshotReference snapshot(this);
+            return snapshot->connections.size() == 1;
+        }
+
+        base::ChannelElementBase* ConnectionManager::getCurrentChannel() const
+        { SnapshotReference snapshot(this);
+            ChannelDescriptor* current = findCurrentChannel(*snapshot);
+            return current ? current->get<1>().get() : NULL;
+        }
+
+        std::list<ConnectionManager::ChannelDescriptor> ConnectionManager::getChannels() const
+        { SnapshotReference snapshot(this);
+            return std::list<ChannelDescriptor>(snapshot->connections.begin(), snapshot->connections.end());
+        }
 
         void ConnectionManager::addConnection(ConnID* conn_id, ChannelElementBase::shared_ptr channel, ConnPolicy policy)
-        { RTT::os::MutexLock lock(connection_lock);
-            assert(conn_id);
-            ChannelDescriptor descriptor = boost::make_tuple(conn_id, channel, policy);
-            connections.insert(connections.end(), descriptor);
-            if (connections.size() == 1)
-                cur_channel = &(connections.front());
+        {
+            Connections connections;
+            { RTT::os::MutexLock lock(connection_lock);
+                assert(conn_id);
+                connections = active->connections;
+                connections.push_back( boost::make_tuple(conn_id, channel, policy) );
+                publish(connections);
+            }
         }
 
         bool ConnectionManager::removeConnection(ConnID* conn_id)
         {
             ChannelDescriptor descriptor;
+            Connections connections;
             { RTT::os::MutexLock lock(connection_lock);
-                std::list<ChannelDescriptor>::iterator conn_it =
-                    std::find_if(connections.begin(), connections.end(), boost::bind(&ConnectionManager::findMatchingPort, this, conn_id, _1));
-                if (conn_it == connections.end())
+                Connections const& current = active->connections;
+                Connections::const_iterator conn_it =
+                    std::find_if(current.begin(), current.end(), boost::bind(&ConnectionManager::findMatchingPort, this, conn_id, _1));
+                if (conn_it == current.end())
                     return false;
                 descriptor = *conn_it;
-                // Verify whether cur_channel is conn_it before we erase, as
-                // cur_channel is a pointer to an element in connections
-                bool reset_current = cur_channel && (cur_channel->get<1>() == descriptor.get<1>());
-                connections.erase(conn_it);
-                updateCurrentChannel(reset_current);
+                connections.reserve(current.size() - 1);
+                connections.insert(connections.end(), current.begin(), conn_it);
+                connections.insert(connections.end(), conn_it + 1, current.end());
+                // if it was the current channel, the first channel becomes the current one.
+                publish(connections);
             }
 
             // disconnect needs to know if we're from Out->In (forward) or from In->Out
@@ -51,6 +51,7 @@
 #include "List.hpp"
 #include "../ConnPolicy.hpp"
 #include "../os/Mutex.hpp"
+#include "../os/oro_arch.h"
 #include "../base/rtt-base-fwd.hpp"
 #include "../base/ChannelElementBase.hpp"
 #include <boost/tuple/tuple.hpp>
@@ -60,6 +61,7 @@
 #include <rtt/os/Mutex.hpp>
 #include <rtt/os/MutexLock.hpp>
 #include <list>
+#include <vector>
 
 
 namespace RTT
@@ -71,7 +73,12 @@ namespace RTT
          * Manages connections between ports.
          * This class is used for input and output ports
          * in order to manage their channels.
-         * TODO: use the mutex lock !!!
+         *
+         * The connections are published as an immutable snapshot. Reading
+         * and writing a port only takes a reference to the current snapshot,
+         * which never blocks. Adding or removing a connection builds a new
+         * snapshot and swaps it in, and then waits until no thread uses the
+         * previous one anymore. Only these updates take the connection lock.
          */
         class RTT_API ConnectionManager
         {
@@ -114,21 +121,29 @@ namespace RTT
             /** Removes the channel that connects this port to \c port */
             bool disconnect(base::PortInterface* port);
 
+            /**
+             * Calls pred on all connections, and removes the connections for
+             * which it returned true. Removing a connection takes the
+             * connection lock and is not real-time, but only happens when
+             * a channel failed.
+             * @return true if a connection was removed.
+             */
             template<typename Pred>
             bool delete_if(Pred pred) {
-                RTT::os::MutexLock lock(connection_lock);
-                bool result = false;
-                std::list<ChannelDescriptor>::iterator it = connections.begin();
-                while (it != connections.end())
+                std::vector<base::ChannelElementBase::shared_ptr> failed;
                 {
-                    if (pred(*it))
+                    SnapshotReference snapshot(this);
+                    Connections::iterator it = snapshot->connections.begin();
+                    for (; it != snapshot->connections.end(); ++it)
                     {
-                        result = true;
-                        it = connections.erase(it);
+                        if (pred(*it))
+                            failed.push_back( it->get<1>() );
                     }
-                    else ++it;
                 }
-                return result;
+                // the snapshot reference must be released before removing.
+                for (std::vector<base::ChannelElementBase::shared_ptr>::iterator it = failed.begin(); it != failed.end(); ++it)
+                    eraseChannel( *it );
+                return !failed.empty();
             }
 
             /**
@@ -141,58 +156,35 @@ namespace RTT
              */
             template<typename Pred>
             void select_reader_channel(Pred pred, bool copy_old_data) {
-                RTT::os::MutexLock lock(connection_lock);
+                SnapshotReference snapshot(this);
                 ChannelDescriptor *new_channel =
-                    find_if(pred, copy_old_data);
+                    find_if(*snapshot, pred, copy_old_data);
                 if (new_channel)
                 {
                     // We don't clear the current channel (to get it to NoData state), because there is a race
                     // between find_if and this line. We have to accept (in other parts of the code) that eventually,
                     // all channels return 'OldData'.
-                    cur_channel = new_channel;
-                }
-            }
-
-            template<typename Pred>
-            ChannelDescriptor *find_if(Pred pred, bool copy_old_data) {
-                // We only copy OldData in the initial read of the current channel.
-                // if it has no new data, the search over the other channels starts,
-                // but no old data is needed.
-                ChannelDescriptor *channel = cur_channel;
-                if ( channel )
-                    if ( pred( copy_old_data, *channel ) )
-                        return channel;
-
-                std::list<ChannelDescriptor>::iterator result;
-                for (result = connections.begin(); result != connections.end(); ++result) {
-                    if (cur_channel && (result->get<1>() == cur_channel->get<1>())) continue;
-                    if ( pred(false, *result) == true)
-                        return &(*result);
+                    cur_channel = new_channel->get<1>().get();
                 }
-                return NULL;
             }
 
             /**
              * Returns true if this manager manages only one connection.
              * @return
              */
-            bool isSingleConnection() const { return connections.size() == 1; }
+            bool isSingleConnection() const;
 
             /**
              * Returns the first added channel or if select_if was called, the selected channel.
              * @see select_if to change the current channel.
              * @return
              */
-            base::ChannelElementBase* getCurrentChannel() const {
-                return cur_channel ? cur_channel->get<1>().get() : NULL;
-            }
+            base::ChannelElementBase* getCurrentChannel() const;
 
             /**
              * Returns a list of all channels managed by this object.
              */
-            std::list<ChannelDescriptor> getChannels() const {
-                return connections;
-            }
+            std::list<ChannelDescriptor> getChannels() const;
 
             /**
              * Clears (removes) all data in the manager's connections.
@@ -202,21 +194,82 @@ namespace RTT
             void clear();
 
             /**
-             * Locks the mutex protecting the channel element list.
+             * Locks the mutex that serializes changes to the connections.
+             * Reading and writing the port are not blocked by it.
              * */
             void lock() const {
                 connection_lock.lock();
             };
 
             /**
-             * Unlocks the mutex protecting the channel element list.
+             * Unlocks the mutex that serializes changes to the connections.
              * */
             void unlock() const {
                 connection_lock.unlock();
             }
         protected:
+            typedef std::vector<ChannelDescriptor> Connections;
 
-            void updateCurrentChannel(bool reset_current);
+            /**
+             * An immutable list of connections, and the number of
+             * threads that are using it.
+             */
+            struct Snapshot
+            {
+                Snapshot();
+                ~Snapshot();
+                Connections connections;
+                mutable oro_atomic_t readers;
+            };
+
+            /**
+             * Holds a reference to the current snapshot for
+             * as long as it exists.
+             */
+            class RTT_API SnapshotReference
+            {
+                Snapshot* msnapshot;
+                SnapshotReference(const SnapshotReference&);
+                SnapshotReference& operator=(const SnapshotReference&);
+            public:
+                SnapshotReference(const ConnectionManager* manager);
+                ~SnapshotReference();
+                Snapshot* operator->() const { return msnapshot; }
+                Snapshot& operator*() const { return *msnapshot; }
+            };
+            friend class SnapshotReference;
+
+            template<typename Pred>
+            ChannelDescriptor *find_if(Snapshot& snapshot, Pred pred, bool copy_old_data) {
+                // We only copy OldData in the initial read of the current channel.
+                // if it has no new data, the search over the other channels starts,
+                // but no old data is needed.
+                ChannelDescriptor *channel = findCurrentChannel(snapshot);
+                if ( channel )
+                    if ( pred( copy_old_data, *channel ) )
+                        return channel;
+
+                Connections::iterator result;
+                for (result = snapshot.connections.begin(); result != snapshot.connections.end(); ++result) {
+                    if (channel && (result->get<1>() == channel->get<1>())) continue;
+                    if ( pred(false, *result) == true)
+                        return &(*result);
+                }
+                return NULL;
+            }
+
+            /**
+             * Returns the descriptor of the current channel in \a snapshot,
+             * or the first channel if the current channel is not in it.
+             */
+            ChannelDescriptor* findCurrentChannel(Snapshot& snapshot) const;
+
+            /**
+             * Publishes \a connections as the new snapshot and waits until the
+             * previous snapshot is no longer used. The connection lock
+             * must be held.
+             */
+            void publish(Connections& connections);
 
             /** Helper method for disconnect(PortInterface*)
              *
@@ -234,6 +287,13 @@ namespace RTT
              */
             bool eraseConnection(ChannelDescriptor& descriptor);
 
+            /** Helper method for delete_if()
+             *
+             * Removes the connection of \a channel from the list, without
+             * disconnecting it.
+             */
+            void eraseChannel(base::ChannelElementBase::shared_ptr channel);
+
             /** os::Mutex for when it is needed to resize the connections list */
             os::Mutex connection_resize_mtx;
 
@@ -243,19 +303,26 @@ namespace RTT
             base::PortInterface* mport;
 
             /**
-             * A list of all our connections. Only non-null if two or more connections
-             * were added.
+             * The two snapshots: while one is active, the other one
+             * is empty and is used to build the next snapshot.
+             */
+            Snapshot snapshots[2];
+
+            /**
+             * The snapshot that holds the current connections.
              */
-            std::list< ChannelDescriptor > connections;
+            Snapshot* volatile active;
 
             /**
-             * Optimisation in case only one channel is to be managed.
+             * The first element of the current channel. It is only used
+             * to find the current channel in a snapshot, and is never
+             * dereferenced.
              */
-            ChannelDescriptor *cur_channel;
+            base::ChannelElementBase* volatile cur_channel;
 
             /**
              * Lock that should be taken before the list of connections is
-             * accessed or modified
+             * modified
              */
             mutable RTT::os::Mutex connection_lock;
         };
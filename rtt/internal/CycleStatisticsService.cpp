@@ -0,0 +1,162 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  CycleStatisticsService.cpp
+
+                        CycleStatisticsService.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "CycleStatisticsService.hpp"
+#include "../TaskContext.hpp"
+#include "../os/Thread.hpp"
+
+namespace RTT
+{ namespace internal {
+
+    namespace {
+        inline double toSeconds(NANO_TIME ns) { return ns / 1.0e9; }
+    }
+
+    CycleStatisticsService::CycleStatisticsService(TaskContext* owner)
+        : Service("statistics", owner), mowner(owner)
+    {
+        this->doc("Execution time statistics of the updateHook() of this component and of its periodic thread.");
+        this->addOperation("getCycleCount", &CycleStatisticsService::getCycleCount, this)
+                .doc("Get the number of measured updateHook() executions.");
+        this->addOperation("getMinTime", &CycleStatisticsService::getMinTime, this)
+                .doc("Get the shortest updateHook() execution, in seconds.");
+        this->addOperation("getMaxTime", &CycleStatisticsService::getMaxTime, this)
+                .doc("Get the longest updateHook() execution, in seconds.");
+        this->addOperation("getMeanTime", &CycleStatisticsService::getMeanTime, this)
+                .doc("Get the mean updateHook() execution time, in seconds.");
+        this->addOperation("getMaxCpuTime", &CycleStatisticsService::getMaxCpuTime, this)
+                .doc("Get the largest thread CPU time of an updateHook() execution, in seconds. Requires setCpuTimeEnabled(true).");
+        this->addOperation("getMeanCpuTime", &CycleStatisticsService::getMeanCpuTime, this)
+                .doc("Get the mean thread CPU time of an updateHook() execution, in seconds. Requires setCpuTimeEnabled(true).");
+        this->addOperation("getHistogram", &CycleStatisticsService::getHistogram, this)
+                .doc("Get the number of updateHook() executions which took between 2^i and 2^(i+1) nanoseconds, for each i.");
+        this->addOperation("getOverrunCount", &CycleStatisticsService::getOverrunCount, this)
+                .doc("Get the number of periods missed by the thread of this component.");
+        this->addOperation("getMaxJitter", &CycleStatisticsService::getMaxJitter, this)
+                .doc("Get the largest deviation of a wake up of the thread of this component from its period, in seconds.");
+        this->addOperation("getMeanJitter", &CycleStatisticsService::getMeanJitter, this)
+                .doc("Get the mean deviation of a wake up of the thread of this component from its period, in seconds.");
+        this->addOperation("setCpuTimeEnabled", &CycleStatisticsService::setCpuTimeEnabled, this)
+                .doc("Also measure the thread CPU time of each updateHook() execution. This costs a system call per execution.")
+                .arg("enabled", "True to measure the CPU time.");
+        this->addOperation("setEnabled", &CycleStatisticsService::setEnabled, this)
+                .doc("Enable or disable measuring the updateHook() execution times.")
+                .arg("enabled", "True to measure.");
+        this->addOperation("reset", &CycleStatisticsService::reset, this)
+                .doc("Clear the statistics of this component and its thread.");
+    }
+
+    os::CycleStatistics* CycleStatisticsService::threadStatistics() const
+    {
+        if ( !mowner->engine()->getActivity() )
+            return 0;
+        os::Thread* t = dynamic_cast<os::Thread*>( mowner->engine()->getActivity()->thread() );
+        return t ? &t->getCycleStatistics() : 0;
+    }
+
+    unsigned int CycleStatisticsService::getCycleCount() const
+    {
+        return mowner->getCycleStatistics().snapshot().cycles;
+    }
+
+    double CycleStatisticsService::getMinTime() const
+    {
+        return toSeconds( mowner->getCycleStatistics().snapshot().wall_min );
+    }
+
+    double CycleStatisticsService::getMaxTime() const
+    {
+        return toSeconds( mowner->getCycleStatistics().snapshot().wall_max );
+    }
+
+    double CycleStatisticsService::getMeanTime() const
+    {
+        return toSeconds( mowner->getCycleStatistics().snapshot().wallMean() );
+    }
+
+    double CycleStatisticsService::getMaxCpuTime() const
+    {
+        return toSeconds( mowner->getCycleStatistics().snapshot().cpu_max );
+    }
+
+    double CycleStatisticsService::getMeanCpuTime() const
+    {
+        return toSeconds( mowner->getCycleStatistics().snapshot().cpuMean() );
+    }
+
+    std::vector<double> CycleStatisticsService::getHistogram() const
+    {
+        os::CycleStatistics::Snapshot s = mowner->getCycleStatistics().snapshot();
+        return std::vector<double>( s.histogram, s.histogram + os::CycleStatistics::Buckets );
+    }
+
+    unsigned int CycleStatisticsService::getOverrunCount() const
+    {
+        os::CycleStatistics* ts = threadStatistics();
+        return ts ? ts->snapshot().overruns : 0;
+    }
+
+    double CycleStatisticsService::getMaxJitter() const
+    {
+        os::CycleStatistics* ts = threadStatistics();
+        return ts ? toSeconds( ts->snapshot().jitter_max ) : 0.0;
+    }
+
+    double CycleStatisticsService::getMeanJitter() const
+    {
+        os::CycleStatistics* ts = threadStatistics();
+        return ts ? toSeconds( ts->snapshot().jitterMean() ) : 0.0;
+    }
+
+    void CycleStatisticsService::setCpuTimeEnabled(bool enabled)
+    {
+        mowner->getCycleStatistics().setCpuTimeEnabled(enabled);
+    }
+
+    void CycleStatisticsService::setEnabled(bool enabled)
+    {
+        mowner->getCycleStatistics().setEnabled(enabled);
+    }
+
+    void CycleStatisticsService::reset()
+    {
+        mowner->getCycleStatistics().reset();
+        os::CycleStatistics* ts = threadStatistics();
+        if ( ts )
+            ts->reset();
+    }
+}}
@@ -0,0 +1,101 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  CycleStatisticsService.hpp
+
+                        CycleStatisticsService.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_CYCLE_STATISTICS_SERVICE_HPP
+#define ORO_CYCLE_STATISTICS_SERVICE_HPP
+
+#include "../Service.hpp"
+#include "../os/CycleStatistics.hpp"
+#include <vector>
+
+namespace RTT
+{ namespace internal {
+
+    /**
+     * The 'statistics' service of a TaskContext. It reports the
+     * execution times of the component's updateHook() and, when it
+     * runs in a periodic thread, the overruns and wake up jitter of
+     * that thread. All times are in seconds.
+     * @see os::CycleStatistics
+     */
+    class RTT_API CycleStatisticsService
+        : public Service
+    {
+    public:
+        /**
+         * Creates the service. You need to add it to the
+         * provided services of \a owner yourself.
+         */
+        CycleStatisticsService(TaskContext* owner);
+
+        unsigned int getCycleCount() const;
+        double getMinTime() const;
+        double getMaxTime() const;
+        double getMeanTime() const;
+        double getMaxCpuTime() const;
+        double getMeanCpuTime() const;
+
+        /**
+         * Returns the number of cycles in each bucket of the
+         * histogram of the wall clock times.
+         */
+        std::vector<double> getHistogram() const;
+
+        unsigned int getOverrunCount() const;
+        double getMaxJitter() const;
+        double getMeanJitter() const;
+
+        void setCpuTimeEnabled(bool enabled);
+        void setEnabled(bool enabled);
+
+        /**
+         * Clear the statistics of the component and its thread.
+         */
+        void reset();
+
+    private:
+        /**
+         * Returns the statistics of the periodic thread executing
+         * the owner, or null if it has none.
+         */
+        os::CycleStatistics* threadStatistics() const;
+
+        TaskContext* mowner;
+    };
+}}
+
+#endif
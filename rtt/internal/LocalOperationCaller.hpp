@@ -47,6 +47,7 @@
 #include "../base/OperationCallerBase.hpp"
 #include "../base/OperationBase.hpp"
 #include "BindStorage.hpp"
+#include "Completion.hpp"
 #include "../SendStatus.hpp"
 #include "../SendHandle.hpp"
 #include "../ExecutionEngine.hpp"
@@ -102,6 +103,8 @@ namespace RTT
                     //cout << "executed method"<<endl;
                     if(this->retv.isError())
                         this->reportError();
+                    // wake up the thread waiting in collect(), if any.
+                    completion.complete();
                     bool result = false;
                     if ( this->caller){
                         result = this->caller->process(this);
@@ -292,55 +295,55 @@ namespace RTT
 
             SendStatus collect_impl() {
                 if (!checkCaller()) return CollectFailure;
-                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)) );
+                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)), &completion );
                 return this->collectIfDone_impl();
             }
             template<class T1>
             SendStatus collect_impl( T1& a1 ) {
                 if (!checkCaller()) return CollectFailure;
-                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)) );
+                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)), &completion );
                 return this->collectIfDone_impl(a1);
             }
 
             template<class T1, class T2>
             SendStatus collect_impl( T1& a1, T2& a2 ) {
                 if (!checkCaller()) return CollectFailure;
-                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)) );
+                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)), &completion );
                 return this->collectIfDone_impl(a1,a2);
             }
 
             template<class T1, class T2, class T3>
             SendStatus collect_impl( T1& a1, T2& a2, T3& a3 ) {
                 if (!checkCaller()) return CollectFailure;
-                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)) );
+                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)), &completion );
                 return this->collectIfDone_impl(a1,a2,a3);
             }
 
 	    template<class T1, class T2, class T3, class T4>
             SendStatus collect_impl( T1& a1, T2& a2, T3& a3, T4& a4) {
                 if (!checkCaller()) return CollectFailure;
-                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)) );
+                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)), &completion );
                 return this->collectIfDone_impl(a1,a2,a3,a4);
             }
 
 	    template<class T1, class T2, class T3, class T4, class T5>
 	    SendStatus collect_impl( T1& a1, T2& a2, T3& a3, T4& a4, T5& a5) {
                 if (!checkCaller()) return CollectFailure;
-                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)) );
+                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)), &completion );
                 return this->collectIfDone_impl(a1,a2,a3,a4, a5);
             }
 
 	    template<class T1, class T2, class T3, class T4, class T5, class T6>
 	    SendStatus collect_impl( T1& a1, T2& a2, T3& a3, T4& a4, T5& a5, T6& a6) {
                 if (!checkCaller()) return CollectFailure;
-                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)) );
+                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)), &completion );
                 return this->collectIfDone_impl(a1,a2,a3,a4,a5,a6);
             }
 
 	    template<class T1, class T2, class T3, class T4, class T5, class T6, class T7>
 	    SendStatus collect_impl( T1& a1, T2& a2, T3& a3, T4& a4, T5& a5, T6& a6, T7& a7) {
                 if (!checkCaller()) return CollectFailure;
-                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)) );
+                this->caller->waitForMessages( boost::bind(&Store::RStoreType::isExecuted,boost::ref(this->retv)), &completion );
                 return this->collectIfDone_impl(a1,a2,a3,a4,a5,a6,a7);
             }
 
@@ -624,6 +627,11 @@ namespace RTT
              * were allocated with the rt_allocator class.
              */
             typename base::OperationCallerBase<FunctionT>::shared_ptr self;
+            /**
+             * Completed when this clone was executed, such that only
+             * the thread collecting it is woken up.
+             */
+            Completion completion;
         };
 
         /**
@@ -0,0 +1,134 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  ParallelChildren.cpp
+
+                        ParallelChildren.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "ParallelChildren.hpp"
+#include "../ExecutionEngine.hpp"
+#include "../extras/ThreadPoolActivity.hpp"
+#include "../base/RunnableInterface.hpp"
+#include "../os/CAS.hpp"
+#include <algorithm>
+
+namespace RTT
+{ namespace internal {
+
+    using namespace detail;
+
+    /**
+     * Executes one child when armed by run().
+     */
+    struct ParallelChildren::Runner
+        : public base::RunnableInterface
+    {
+        ParallelChildren* owner;
+        base::TaskCore* child;
+        volatile int armed;
+
+        Runner(ParallelChildren* o) : owner(o), child(0), armed(0) {}
+
+        bool initialize() { return true; }
+        void finalize() {}
+        void step() {
+            // ThreadPoolActivity::start() runs us once without a child.
+            if ( !os::CAS(&armed, 1, 0) )
+                return;
+            owner->execute( child );
+        }
+    };
+
+    ParallelChildren::ParallelChildren(ExecutionEngine* engine, unsigned int workers,
+                                       int scheduler, int priority, unsigned cpu_affinity)
+        : mengine(engine),
+          mpool( new extras::ThreadPool(workers, scheduler, priority, cpu_affinity, 256, "ParallelChildren") ),
+          mfull(false), mpending(0), mdone(0)
+    {
+    }
+
+    ParallelChildren::~ParallelChildren()
+    {
+        for (unsigned int i = 0; i != macts.size(); ++i) {
+            macts[i]->stop();
+            delete macts[i];
+            delete mrunners[i];
+        }
+    }
+
+    unsigned int ParallelChildren::getWorkerCount() const
+    {
+        return mpool->getWorkerCount();
+    }
+
+    void ParallelChildren::execute(base::TaskCore* child)
+    {
+        mengine->processChild( child );
+        if ( mpending.dec_and_test() )
+            mdone.signal();
+    }
+
+    void ParallelChildren::run(const std::vector<base::TaskCore*>& children)
+    {
+        if ( children.empty() )
+            return;
+        // only allocates when the number of children grew.
+        while ( !mfull && macts.size() < children.size() - 1 ) {
+            Runner* r = new Runner(this);
+            extras::ThreadPoolActivity* act = new extras::ThreadPoolActivity(mpool, r);
+            if ( !act->start() ) {
+                delete act;
+                delete r;
+                mfull = true;
+                break;
+            }
+            mrunners.push_back(r);
+            macts.push_back(act);
+        }
+
+        unsigned int remote = std::min( (unsigned int)macts.size(), (unsigned int)children.size() - 1 );
+        mpending.set( remote );
+        for (unsigned int i = 0; i != remote; ++i) {
+            mrunners[i]->child = children[i + 1];
+            mrunners[i]->armed = 1;
+            // execute the child here if the pool refused it.
+            if ( !macts[i]->trigger() && os::CAS(&mrunners[i]->armed, 1, 0) )
+                execute( children[i + 1] );
+        }
+        mengine->processChild( children[0] );
+        for (unsigned int i = remote + 1; i < children.size(); ++i)
+            mengine->processChild( children[i] );
+        if ( remote != 0 )
+            mdone.wait();
+    }
+}}
@@ -0,0 +1,110 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  ParallelChildren.hpp
+
+                        ParallelChildren.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_PARALLEL_CHILDREN_HPP
+#define ORO_PARALLEL_CHILDREN_HPP
+
+#include "../extras/ThreadPool.hpp"
+#include "../os/Atomic.hpp"
+#include "../os/Semaphore.hpp"
+#include "../rtt-fwd.hpp"
+#include <vector>
+
+namespace RTT
+{ namespace internal {
+
+    /**
+     * Executes the children of an ExecutionEngine in parallel on a
+     * ThreadPool. run() hands all children but the first to the pool,
+     * executes the first one in the calling thread and returns when
+     * all children were executed.
+     *
+     * Each child gets a ThreadPoolActivity, which are created the
+     * first time run() is called with that many children. When the
+     * pool accepts no more activities, the remaining children are
+     * executed in the calling thread.
+     */
+    class RTT_API ParallelChildren
+    {
+    public:
+        /**
+         * Creates a pool of \a workers threads for the children of \a engine.
+         */
+        ParallelChildren(ExecutionEngine* engine, unsigned int workers,
+                         int scheduler, int priority, unsigned cpu_affinity);
+
+        ~ParallelChildren();
+
+        unsigned int getWorkerCount() const;
+
+        /**
+         * Executes ExecutionEngine::processChild() for all \a children
+         * and waits until all returned.
+         */
+        void run(const std::vector<base::TaskCore*>& children);
+
+    private:
+        ParallelChildren(const ParallelChildren&);
+
+        struct Runner;
+
+        /**
+         * Executes a child which was handed to the pool.
+         */
+        void execute(base::TaskCore* child);
+
+        ExecutionEngine* mengine;
+        extras::ThreadPool::shared_ptr mpool;
+        std::vector<Runner*> mrunners;
+        std::vector<extras::ThreadPoolActivity*> macts;
+        /**
+         * Set when the pool refused an activity.
+         */
+        bool mfull;
+        /**
+         * The number of children which are still being executed
+         * by the pool.
+         */
+        os::AtomicInt mpending;
+        /**
+         * Signaled when mpending drops to zero.
+         */
+        os::Semaphore mdone;
+    };
+}}
+
+#endif
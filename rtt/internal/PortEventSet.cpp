@@ -0,0 +1,174 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  PortEventSet.cpp
+
+                        PortEventSet.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PortEventSet.hpp"
+#include "../base/PortInterface.hpp"
+#include "../os/MutexLock.hpp"
+#include "../os/CAS.hpp"
+#include "../os/fosi.h"
+
+namespace RTT
+{ namespace internal {
+
+    PortEventSet::Table::Table()
+        : queue(0)
+    {
+        ORO_ATOMIC_SETUP(&readers, 0);
+    }
+
+    PortEventSet::Table::~Table()
+    {
+        delete queue;
+        ORO_ATOMIC_CLEANUP(&readers);
+    }
+
+    PortEventSet::TableReference::TableReference(const PortEventSet* set)
+    {
+        // A reference is only valid if the table was still active after
+        // taking it. Otherwise, publish() may already be waiting for it.
+        while (true) {
+            mtable = set->active;
+            oro_atomic_inc( &mtable->readers );
+            if ( mtable == set->active )
+                return;
+            oro_atomic_dec( &mtable->readers );
+        }
+    }
+
+    PortEventSet::TableReference::~TableReference()
+    {
+        oro_atomic_dec( &mtable->readers );
+    }
+
+    PortEventSet::PortEventSet()
+        : active(&tables[0])
+    {
+        tables[0].queue = new AtomicMWSRQueue<int>(1);
+    }
+
+    PortEventSet::~PortEventSet()
+    {
+    }
+
+    void PortEventSet::setCallback(base::PortInterface* port, SlotFunction const& callback)
+    {
+        os::MutexLock locker(lock);
+        Slots slots = active->slots;
+        int index = port->mevent_slot;
+        if ( index < 0 || index >= (int)slots.size() || slots[index].port != port ) {
+            // take the first free slot, such that indices remain stable.
+            for (index = 0; index != (int)slots.size() && slots[index].port; ++index);
+            if ( index == (int)slots.size() )
+                slots.push_back( Slot() );
+            slots[index].port = port;
+            port->mevent_pending = 0;
+            port->mevent_slot = index;
+        }
+        slots[index].callback = callback;
+        publish(slots);
+    }
+
+    void PortEventSet::removeCallback(base::PortInterface* port)
+    {
+        os::MutexLock locker(lock);
+        int index = port->mevent_slot;
+        Slots slots = active->slots;
+        if ( index < 0 || index >= (int)slots.size() || slots[index].port != port )
+            return;
+        slots[index] = Slot();
+        // drops the pending event of port.
+        publish(slots);
+        port->mevent_slot = -1;
+        port->mevent_pending = 0;
+    }
+
+    void PortEventSet::push(base::PortInterface* port)
+    {
+        TableReference table(this);
+        int index = port->mevent_slot;
+        if ( index < 0 || index >= (int)table->slots.size() || table->slots[index].port != port )
+            return;
+        if ( os::CAS(&port->mevent_pending, 0, 1) )
+            table->queue->enqueue( index + 1 );
+    }
+
+    void PortEventSet::process()
+    {
+        TableReference table(this);
+        // ports that are queued again by their callback are left for the
+        // next call, which their trigger will cause.
+        AtomicMWSRQueue<int>::size_type count = table->queue->size();
+        int item;
+        while ( count-- != 0 && table->queue->dequeue( item ) ) {
+            Slot& slot = table->slots[item - 1];
+            if ( !slot.port )
+                continue;
+            // clear first: new data from here on queues the port again.
+            os::CAS(&slot.port->mevent_pending, 1, 0);
+            if ( slot.callback )
+                slot.callback( slot.port );
+        }
+    }
+
+    void PortEventSet::publish(Slots& slots)
+    {
+        Table* previous = active;
+        Table* next = (previous == &tables[0]) ? &tables[1] : &tables[0];
+        // next is unused: it was emptied when it was replaced.
+        next->slots.swap(slots);
+        next->queue = new AtomicMWSRQueue<int>( next->slots.empty() ? 1 : next->slots.size() );
+        os::CAS(&active, previous, next);
+
+        // wait until all readers of the previous table are gone.
+        TIME_SPEC ts;
+        ts.tv_sec = 0;
+        ts.tv_nsec = 1000;
+        while ( oro_atomic_read(&previous->readers) != 0 )
+            rtos_nanosleep(&ts, NULL);
+
+        // ports that were marked pending in the previous table are not
+        // queued again: move their events over.
+        int item;
+        while ( previous->queue->dequeue( item ) )
+            if ( item - 1 < (int)next->slots.size() && next->slots[item - 1].port )
+                next->queue->enqueue( item );
+        delete previous->queue;
+        previous->queue = 0;
+        previous->slots.clear();
+    }
+
+}}
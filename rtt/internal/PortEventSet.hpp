@@ -0,0 +1,149 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  PortEventSet.hpp
+
+                        PortEventSet.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_PORT_EVENT_SET_HPP
+#define ORO_PORT_EVENT_SET_HPP
+
+#include "AtomicMWSRQueue.hpp"
+#include "../os/Mutex.hpp"
+#include "../os/oro_arch.h"
+#include "../base/rtt-base-fwd.hpp"
+#include "../rtt-config.h"
+#include <boost/function.hpp>
+#include <vector>
+
+namespace RTT
+{ namespace internal {
+
+    /**
+     * The set of event ports of a TaskContext that received new data
+     * and have a callback to run in the TaskContext's thread.
+     *
+     * Each port is marked pending with an atomic flag in the port, such
+     * that it is queued at most once, however many samples arrive, until
+     * its callback runs. The queue therefore never overflows.
+     *
+     * The callbacks are stored in a table indexed by port, which is
+     * published as an immutable snapshot, like the connections of a port
+     * in ConnectionManager. push() and process() never take a lock, adding
+     * or removing a callback waits until both are done with the
+     * previous table.
+     */
+    class RTT_API PortEventSet
+    {
+    public:
+        typedef boost::function<void(base::PortInterface*)> SlotFunction;
+
+        PortEventSet();
+        ~PortEventSet();
+
+        /**
+         * Sets the function to call in process() when \a port has new data.
+         * Replaces an earlier callback of \a port.
+         */
+        void setCallback(base::PortInterface* port, SlotFunction const& callback);
+
+        /**
+         * Removes the callback of \a port, and drops its pending event.
+         */
+        void removeCallback(base::PortInterface* port);
+
+        /**
+         * Marks \a port as having new data. Does nothing if the port has no
+         * callback or is already pending. May be called by any thread.
+         */
+        void push(base::PortInterface* port);
+
+        /**
+         * Calls the callbacks of the ports that were pending when this
+         * function was entered. Only one thread may call this function.
+         */
+        void process();
+
+    private:
+        struct Slot
+        {
+            Slot() : port(0) {}
+            base::PortInterface* port;
+            SlotFunction callback;
+        };
+        typedef std::vector<Slot> Slots;
+
+        struct Table
+        {
+            Table();
+            ~Table();
+            Slots slots;
+            /** Holds the slot index + 1 of each pending port. */
+            AtomicMWSRQueue<int>* queue;
+            mutable oro_atomic_t readers;
+        };
+
+        /**
+         * Holds a reference to the current table for
+         * as long as it lives.
+         */
+        class TableReference
+        {
+            Table* mtable;
+            TableReference(const TableReference&);
+            TableReference& operator=(const TableReference&);
+        public:
+            TableReference(const PortEventSet* set);
+            ~TableReference();
+            Table* operator->() const { return mtable; }
+        };
+        friend class TableReference;
+
+        /**
+         * Publishes \a slots as the new table, waits until the previous one
+         * is no longer used and moves its pending events over.
+         * The lock must be held.
+         */
+        void publish(Slots& slots);
+
+        Table tables[2];
+        Table* volatile active;
+        /** Serializes changes to the table. */
+        os::Mutex lock;
+
+        PortEventSet(const PortEventSet&);
+    };
+
+}}
+
+#endif
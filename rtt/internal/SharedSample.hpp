@@ -0,0 +1,494 @@
+/***************************************************************************
+  tag: Orocos RTT  Fri Oct 16 12:00:00 CEST 2026  SharedSample.hpp
+
+                        SharedSample.hpp -  description
+                           -------------------
+    begin                : Fri October 16 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_SHARED_SAMPLE_HPP
+#define ORO_SHARED_SAMPLE_HPP
+
+#include "../os/oro_arch.h"
+#include "../os/Atomic.hpp"
+#include "../os/Mutex.hpp"
+#include "../os/MutexLock.hpp"
+#include "../base/DataObject.hpp"
+#include "TsPool.hpp"
+#include <boost/intrusive_ptr.hpp>
+#include <vector>
+
+namespace RTT
+{ namespace internal {
+
+    template<typename T>
+    class SharedSamplePool;
+
+    template<typename T>
+    class LoanedSample;
+
+    /**
+     * An immutable, reference counted data sample. An OutputPort in shared
+     * sample mode copies each written sample once into a SharedSample and
+     * hands out references to it to all its connections, such that the cost
+     * of a write does not grow with the number of readers.
+     *
+     * SharedSample objects are allocated from a SharedSamplePool and return
+     * to it when the last reference is dropped.
+     */
+    template<typename T>
+    class SharedSample
+    {
+    public:
+        typedef T value_t;
+        typedef boost::intrusive_ptr< SharedSample<T> > shared_ptr;
+        typedef TsPool< SharedSample<T> > Chunk;
+
+        SharedSample()
+            : value(), chunk(0), owner(0), generation(0)
+        {
+            ORO_ATOMIC_SETUP(&refcount, 0);
+        }
+
+        SharedSample(const T& sample, Chunk* chunk, SharedSamplePool<T>* owner, unsigned int generation = 0)
+            : value(sample), chunk(chunk), owner(owner), generation(generation)
+        {
+            ORO_ATOMIC_SETUP(&refcount, 0);
+        }
+
+        /**
+         * Copies the value and the pool membership, but not the
+         * reference count.
+         */
+        SharedSample(const SharedSample& orig)
+            : value(orig.value), chunk(orig.chunk), owner(orig.owner), generation(orig.generation)
+        {
+            ORO_ATOMIC_SETUP(&refcount, 0);
+        }
+
+        SharedSample& operator=(const SharedSample& orig)
+        {
+            value = orig.value;
+            chunk = orig.chunk;
+            owner = orig.owner;
+            generation = orig.generation;
+            return *this;
+        }
+
+        ~SharedSample()
+        {
+            ORO_ATOMIC_CLEANUP(&refcount);
+        }
+
+        /**
+         * Returns a read-only view on the data of this sample.
+         */
+        const T& get() const { return value; }
+
+        /** Increases the reference count */
+        void ref() { oro_atomic_inc(&refcount); }
+
+        /**
+         * Decreases the reference count, and returns this sample to
+         * its pool if it is zero.
+         */
+        void deref()
+        {
+            if ( oro_atomic_dec_and_test(&refcount) ) {
+                // cache the owner: once deallocated, this slot may be reused.
+                SharedSamplePool<T>* pool = owner;
+#ifndef OROBLD_OS_NO_ASM
+                if (chunk)
+                    chunk->deallocate(this);
+                else
+#endif
+                    delete this;
+                if (pool)
+                    pool->deref();
+            }
+        }
+
+    private:
+        friend class SharedSamplePool<T>;
+        friend class LoanedSample<T>;
+        T value;
+        Chunk* chunk;
+        SharedSamplePool<T>* owner;
+        /// The data sample of the pool this value was initialized with.
+        unsigned int generation;
+        oro_atomic_t refcount;
+    };
+
+    template<typename T>
+    void intrusive_ptr_add_ref( SharedSample<T>* p )
+    { p->ref(); }
+
+    template<typename T>
+    void intrusive_ptr_release( SharedSample<T>* p )
+    { p->deref(); }
+
+    /**
+     * A lock-free, growable pool of SharedSample objects. The pool
+     * is reference counted by its owner and by every sample that is
+     * handed out, so it outlives all of its samples.
+     *
+     * The pool consists of a number of fixed size chunks, which are
+     * added with reserve() when a connection is created. Samples are
+     * allocated real-time from these chunks. When all chunks are exhausted,
+     * samples are allocated on the heap, which is counted by misses().
+     */
+    template<typename T>
+    class SharedSamplePool
+    {
+    public:
+        typedef boost::intrusive_ptr< SharedSamplePool<T> > shared_ptr;
+        typedef typename SharedSample<T>::shared_ptr sample_ptr;
+        typedef typename SharedSample<T>::Chunk Chunk;
+
+        /**
+         * The maximum number of times reserve() can add
+         * capacity to this pool.
+         */
+        static const int MAX_CHUNKS = 32;
+
+        /**
+         * Creates an empty pool. Call reserve() to add capacity.
+         * @param sample The data sample used to initialize every
+         * slot in the pool.
+         */
+        SharedSamplePool(const T& sample = T())
+            : msample(sample), mgeneration(0), mcapacity(0), mmisses(0)
+        {
+            ORO_ATOMIC_SETUP(&refcount, 0);
+            ORO_ATOMIC_SETUP(&nchunks, 0);
+            for (int i = 0; i != MAX_CHUNKS; ++i)
+                chunks[i] = 0;
+        }
+
+        ~SharedSamplePool()
+        {
+            for (int i = 0; i != oro_atomic_read(&nchunks); ++i)
+                delete chunks[i];
+            ORO_ATOMIC_CLEANUP(&nchunks);
+            ORO_ATOMIC_CLEANUP(&refcount);
+        }
+
+        /**
+         * Adds room for \a n more samples to this pool.
+         * @return false if the pool can not grow any further.
+         * @nrt
+         */
+        bool reserve(unsigned int n)
+        {
+#ifndef OROBLD_OS_NO_ASM
+            os::MutexLock lock(mlock);
+            int count = oro_atomic_read(&nchunks);
+            if (n == 0)
+                return true;
+            if (count == MAX_CHUNKS)
+                return false;
+            Chunk* chunk = new Chunk(n);
+            chunk->data_sample( SharedSample<T>(msample, chunk, this, mgeneration) );
+            chunks[count] = chunk;
+            mcapacity += n;
+            // publishes the new chunk to allocate().
+            oro_atomic_inc(&nchunks);
+            return true;
+#else
+            // No lock-free pool available: all samples come from the heap.
+            return false;
+#endif
+        }
+
+        /**
+         * Returns a new shared sample holding a copy of \a value.
+         * @rt if the pool has a free slot, otherwise a heap allocation is done.
+         */
+        sample_ptr allocate(const T& value)
+        {
+            SharedSample<T>* item = take();
+            if (item)
+                item->value = value;
+            else
+                item = new SharedSample<T>(value, 0, this);
+            return sample_ptr(item);
+        }
+
+        /**
+         * Lends out a sample of this pool for writing in place. The
+         * data of the loaned sample is left as it was when the slot was
+         * last used, or is the data sample if it was never used.
+         * @rt if the pool has a free slot, otherwise a heap allocation is done.
+         * @see LoanedSample
+         */
+        LoanedSample<T> loan()
+        {
+            SharedSample<T>* item = take();
+            if (!item)
+                item = new SharedSample<T>(msample, 0, this, mgeneration);
+            else if (item->generation != mgeneration) {
+                // the slot was in use during the last data_sample().
+                item->value = msample;
+                item->generation = mgeneration;
+            }
+            return LoanedSample<T>( sample_ptr(item) );
+        }
+
+        /**
+         * Initializes every free slot in the pool with the given sample,
+         * such that dynamically sized types have enough memory
+         * reserved. Slots that are in use are initialized when they
+         * are loaned the next time.
+         * @nrt
+         */
+        void data_sample(const T& sample)
+        {
+            os::MutexLock lock(mlock);
+            msample = sample;
+            ++mgeneration;
+#ifndef OROBLD_OS_NO_ASM
+            std::vector< SharedSample<T>* > items;
+            items.reserve(mcapacity);
+            for (int i = 0; i != oro_atomic_read(&nchunks); ++i) {
+                SharedSample<T>* item;
+                while ( (item = chunks[i]->allocate()) ) {
+                    item->value = sample;
+                    item->generation = mgeneration;
+                    items.push_back(item);
+                }
+            }
+            for (typename std::vector< SharedSample<T>* >::iterator it = items.begin(); it != items.end(); ++it)
+                (*it)->chunk->deallocate(*it);
+#endif
+        }
+
+        /**
+         * Reads back the data sample.
+         */
+        T data_sample() const
+        {
+            os::MutexLock lock(mlock);
+            return msample;
+        }
+
+        /**
+         * The number of samples that can be allocated without
+         * falling back to the heap.
+         */
+        unsigned int capacity() const
+        {
+            os::MutexLock lock(mlock);
+            return mcapacity;
+        }
+
+        /**
+         * The number of samples that were allocated on the heap
+         * because the pool was exhausted.
+         */
+        int misses() const
+        {
+            return mmisses.read();
+        }
+
+        /** Increases the reference count */
+        void ref() { oro_atomic_inc(&refcount); }
+
+        /** Decreases the reference count, and deletes this pool if it is zero */
+        void deref()
+        {
+            if ( oro_atomic_dec_and_test(&refcount) ) delete this;
+        }
+
+    private:
+        SharedSamplePool(const SharedSamplePool&);
+        SharedSamplePool& operator=(const SharedSamplePool&);
+
+        /**
+         * Takes a free slot from the chunks, or returns null and counts
+         * a miss if all are in use. The pool is referenced on behalf of
+         * the sample that will occupy the slot.
+         */
+        SharedSample<T>* take()
+        {
+            SharedSample<T>* item = 0;
+#ifndef OROBLD_OS_NO_ASM
+            int count = oro_atomic_read(&nchunks);
+            for (int i = 0; i != count && item == 0; ++i)
+                item = chunks[i]->allocate();
+#endif
+            if (!item)
+                mmisses.inc();
+            this->ref();
+            return item;
+        }
+
+        T msample;
+        unsigned int mgeneration;
+        Chunk* chunks[MAX_CHUNKS];
+        oro_atomic_t nchunks;
+        unsigned int mcapacity;
+        os::AtomicInt mmisses;
+        oro_atomic_t refcount;
+        mutable os::Mutex mlock;
+    };
+
+    template<typename T>
+    void intrusive_ptr_add_ref( SharedSamplePool<T>* p )
+    { p->ref(); }
+
+    template<typename T>
+    void intrusive_ptr_release( SharedSamplePool<T>* p )
+    { p->deref(); }
+
+    /**
+     * A sample lent out by a SharedSamplePool, which can be written in
+     * place. As long as it is loaned, the sample is only referenced by
+     * this object. release() turns it into an immutable SharedSample that
+     * can be handed out to readers, for example with OutputPort::commit().
+     *
+     * A LoanedSample is moved, not copied: copying or assigning transfers
+     * the loan and leaves the original empty. If it is destroyed while
+     * still holding a sample, that sample returns to its pool unpublished.
+     */
+    template<typename T>
+    class LoanedSample
+    {
+    public:
+        typedef typename SharedSample<T>::shared_ptr sample_ptr;
+
+        /**
+         * Creates an empty loan.
+         */
+        LoanedSample() {}
+
+        explicit LoanedSample(sample_ptr sample)
+            : msample(sample) {}
+
+        LoanedSample(const LoanedSample& orig)
+            : msample( const_cast<LoanedSample&>(orig).release() ) {}
+
+        LoanedSample& operator=(const LoanedSample& orig)
+        {
+            if (this != &orig)
+                msample = const_cast<LoanedSample&>(orig).release();
+            return *this;
+        }
+
+        /**
+         * Returns true if this object holds a sample.
+         */
+        bool valid() const { return msample.get() != 0; }
+
+        /**
+         * Returns the data of the loaned sample, for writing in place.
+         * @pre valid()
+         */
+        T& value() const { return msample->value; }
+
+        T& operator*() const { return value(); }
+
+        T* operator->() const { return &value(); }
+
+        /**
+         * Ends the loan and returns the sample, which must
+         * no longer be modified.
+         * @post !valid()
+         */
+        sample_ptr release()
+        {
+            sample_ptr result;
+            result.swap(msample);
+            return result;
+        }
+
+    private:
+        sample_ptr msample;
+    };
+
+    /**
+     * The data object an OutputPort in shared sample mode uses to keep
+     * its last written value. It stores a reference to the shared sample
+     * instead of a copy of the data.
+     */
+    template<typename T>
+    class SharedDataObject
+        : public base::DataObjectInterface<T>
+    {
+    public:
+        typedef typename SharedSample<T>::shared_ptr sample_ptr;
+
+        SharedDataObject(typename SharedSamplePool<T>::shared_ptr pool, const T& initial_value = T())
+            : mpool(pool)
+        {
+            Set(initial_value);
+        }
+
+        virtual void Get( T& pull ) const
+        {
+            sample_ptr sample = mdata.Get();
+            if (sample)
+                pull = sample->get();
+        }
+
+        virtual T Get() const
+        {
+            T cache = T();
+            Get(cache);
+            return cache;
+        }
+
+        virtual void Set( const T& push )
+        {
+            mdata.Set( mpool->allocate(push) );
+        }
+
+        /**
+         * Stores a reference to \a sample, without copying its data.
+         */
+        void SetShared( sample_ptr const& sample )
+        {
+            mdata.Set( sample );
+        }
+
+        virtual void data_sample( const T& sample )
+        {
+            Set( sample );
+            mpool->data_sample( sample );
+        }
+
+    private:
+        typename SharedSamplePool<T>::shared_ptr mpool;
+        base::DataObject<sample_ptr> mdata;
+    };
+}}
+
+#endif
@@ -0,0 +1,110 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  TriggerCoalescer.cpp
+
+                        TriggerCoalescer.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "TriggerCoalescer.hpp"
+#include "../base/TaskCore.hpp"
+#include "../base/ActivityInterface.hpp"
+#include "../ExecutionEngine.hpp"
+#include "../os/CAS.hpp"
+
+namespace RTT
+{ namespace internal {
+
+    TriggerCoalescer::TriggerCoalescer(base::TaskCore* owner, Seconds min_interval, unsigned int max_samples,
+                                       int scheduler, int priority)
+        : os::Timer(1, scheduler, priority), mowner(owner),
+          mmin_interval( Seconds_to_nsecs(min_interval) ), mmax_samples(max_samples),
+          mlast_trigger(0), mpending(0), marmed(0), mtriggers(0), msuppressed(0)
+    {
+    }
+
+    TriggerCoalescer::~TriggerCoalescer()
+    {
+        // stop the timer thread before our members are gone.
+        if (mThread)
+            mThread->stop();
+    }
+
+    void TriggerCoalescer::trigger()
+    {
+        int pending;
+        do {
+            pending = mpending;
+        } while ( !os::CAS(&mpending, pending, pending + 1) );
+        ++pending;
+
+        os::TimeService::nsecs elapsed = os::TimeService::Instance()->getNSecs() - mlast_trigger;
+        if ( elapsed >= mmin_interval || (mmax_samples != 0 && pending >= mmax_samples) ) {
+            fire();
+            return;
+        }
+        msuppressed.inc();
+        // one catch-up per interval: the timer triggers for all samples
+        // that arrive before it expires.
+        if ( os::CAS(&marmed, 0, 1) )
+            this->arm(0, nsecs_to_Seconds(mmin_interval - elapsed) );
+    }
+
+    void TriggerCoalescer::timeout(TimerId)
+    {
+        os::CAS(&marmed, 1, 0);
+        // samples that saw the timer armed are counted in mpending.
+        if ( mpending != 0 )
+            fire();
+    }
+
+    void TriggerCoalescer::fire()
+    {
+        mpending = 0;
+        mlast_trigger = os::TimeService::Instance()->getNSecs();
+        mtriggers.inc();
+        base::ActivityInterface* act = mowner->engine()->getActivity();
+        if (act)
+            act->trigger();
+    }
+
+    unsigned int TriggerCoalescer::getTriggerCount() const
+    {
+        return mtriggers.read();
+    }
+
+    unsigned int TriggerCoalescer::getSuppressedCount() const
+    {
+        return msuppressed.read();
+    }
+
+}}
@@ -0,0 +1,113 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  TriggerCoalescer.hpp
+
+                        TriggerCoalescer.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_TRIGGER_COALESCER_HPP
+#define ORO_TRIGGER_COALESCER_HPP
+
+#include "../os/Timer.hpp"
+#include "../os/Atomic.hpp"
+#include "../os/TimeService.hpp"
+#include "../base/rtt-base-fwd.hpp"
+#include "../rtt-config.h"
+
+namespace RTT
+{ namespace internal {
+
+    /**
+     * Merges the triggers that event ports send to the activity of a
+     * component. The activity is triggered at most once per minimum
+     * interval, or earlier when a given number of samples is pending.
+     * A trigger that is suppressed is caught up by a timer at the end of
+     * the interval, such that no sample waits longer than the interval.
+     *
+     * trigger() may be called concurrently by any number of writers.
+     */
+    class RTT_API TriggerCoalescer
+        : protected os::Timer
+    {
+    public:
+        /**
+         * Creates a coalescer for the activity of \a owner.
+         * @param owner The component to trigger.
+         * @param min_interval The minimum time between two triggers, in seconds.
+         * @param max_samples Trigger as soon as this number of samples is
+         * pending, even within the interval. Zero means no limit.
+         * @param scheduler The scheduler of the catch-up timer thread.
+         * @param priority The priority of the catch-up timer thread.
+         */
+        TriggerCoalescer(base::TaskCore* owner, Seconds min_interval, unsigned int max_samples,
+                         int scheduler, int priority);
+
+        ~TriggerCoalescer();
+
+        /**
+         * Informs the coalescer that a new sample arrived. The activity is
+         * triggered now if the interval has passed since the previous
+         * trigger or if enough samples are pending, and later otherwise.
+         */
+        void trigger();
+
+        /**
+         * Returns the number of times the activity was triggered.
+         */
+        unsigned int getTriggerCount() const;
+
+        /**
+         * Returns the number of samples that did not trigger the activity
+         * because a trigger was merged with an earlier or later one.
+         */
+        unsigned int getSuppressedCount() const;
+
+    protected:
+        void timeout(TimerId timer_id);
+
+    private:
+        void fire();
+
+        base::TaskCore* mowner;
+        const os::TimeService::nsecs mmin_interval;
+        const int mmax_samples;
+        volatile os::TimeService::nsecs mlast_trigger;
+        volatile int mpending;
+        volatile int marmed;
+        os::AtomicInt mtriggers;
+        os::AtomicInt msuppressed;
+    };
+
+}}
+
+#endif
@@ -56,7 +56,13 @@ namespace RTT
 
         /**
          * A multi-reader multi-writer MemoryPool implementation.
-         * It can hold max 65535 elements of type T.
+         * It can hold max 2^32 - 1 elements of type T.
+         *
+         * The free list is a linked list of indices, of which the head
+         * is swapped with a 64 bit CAS, together with a 32 bit tag that
+         * prevents the ABA problem. Items of small types are padded to
+         * a cache line, such that threads using neighbouring items do
+         * not share a cache line.
          */
         template<typename T>
         class TsPool
@@ -66,14 +72,37 @@ namespace RTT
         private:
             union Pointer_t
             {
-                unsigned int value;
+                unsigned long long value;
                 struct _ptr_type
                 {
-                    unsigned short tag;
-                    unsigned short index;
+                    unsigned int tag;
+                    unsigned int index;
                 } ptr;
             };
 
+            /**
+             * The index marking the end of the free list.
+             */
+            static const unsigned int END = (unsigned int) -1;
+
+            enum { CACHE_LINE_SIZE = 64 };
+
+            /**
+             * The unpadded layout of an Item.
+             */
+            struct ItemLayout
+            {
+                value_t value;
+                volatile Pointer_t next;
+            };
+
+            enum { PADDING = sizeof(ItemLayout) < CACHE_LINE_SIZE ? CACHE_LINE_SIZE - sizeof(ItemLayout) : 0 };
+
+            template<unsigned int N, bool dummy = true>
+            struct Padding { char pad[N]; };
+            template<bool dummy>
+            struct Padding<0, dummy> {};
+
             /**
              * The implementation assumes that value
              * is the first element of this struct
@@ -83,6 +112,7 @@ namespace RTT
             {
                 value_t value;
                 volatile Pointer_t next;
+                Padding<PADDING> padding;
 
                 Item() :
                     value(value_t())
@@ -116,7 +146,7 @@ namespace RTT
                 unsigned int i = 0, endseen = 0;
                 for (; i < pool_capacity; i++)
                 {
-                    if (pool[i].next.ptr.index == (unsigned short) -1)
+                    if (pool[i].next.ptr.index == END)
                     {
                         ++endseen;
                     }
@@ -140,7 +170,7 @@ namespace RTT
                 {
                     pool[i].next.ptr.index = i + 1;
                 }
-                pool[pool_capacity - 1].next.ptr.index = (unsigned short) -1;
+                pool[pool_capacity - 1].next.ptr.index = END;
                 head.next.ptr.index = 0;
             }
 
@@ -165,7 +195,7 @@ namespace RTT
                 {
                     oldval.value = head.next.value;
                     //List empty?
-                    if (oldval.ptr.index == (unsigned short) -1)
+                    if (oldval.ptr.index == END)
                     {
                         return 0;
                     }
@@ -207,7 +237,7 @@ namespace RTT
                 unsigned int ret = 0;
                 volatile Item* oldval;
                 oldval = &head;
-                while ( oldval->next.ptr.index != (unsigned short) -1) {
+                while ( oldval->next.ptr.index != END) {
                     ++ret;
                     oldval = &pool[oldval->next.ptr.index];
                     assert(ret <= pool_capacity); // abort on corruption due to concurrency.
@@ -3,18 +3,23 @@
 
 namespace RTT {
     namespace internal {
+        class Completion;
         class ConnFactory;
         class ConnID;
         class ConnectionBase;
         class ConnectionManager;
+        class CycleStatisticsService;
         class DataSourceCommand;
         class GlobalEngine;
         class OffsetDataSource;
         class OperationCallerC;
         class OperationInterfacePartHelper;
+        class ParallelChildren;
+        class PortEventSet;
         class SendHandleC;
         class SignalBase;
         class SimpleConnID;
+        class TriggerCoalescer;
         struct GenerateDataSource;
         struct IntrusiveStorage;
         struct LocalConnID;
@@ -137,6 +142,10 @@ namespace RTT {
         template<typename T>
         class ChannelDataElement;
         template<typename T>
+        class ChannelSharedBufferElement;
+        template<typename T>
+        class ChannelSharedDataElement;
+        template<typename T>
         class ConnInputEndpoint;
         template<typename T>
         class ConnOutputEndpoint;
@@ -153,12 +162,20 @@ namespace RTT {
         template<typename T>
         class LateReferenceDataSource;
         template<typename T>
+        class LoanedSample;
+        template<typename T>
         class OffsetPartDataSource;
         template<typename T>
         class PartDataSource;
         template<typename T>
         class ReferenceDataSource;
         template<typename T>
+        class SharedDataObject;
+        template<typename T>
+        class SharedSample;
+        template<typename T>
+        class SharedSamplePool;
+        template<typename T>
         class TsPool;
         template<typename T>
         class ValueDataSource;
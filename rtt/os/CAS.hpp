@@ -55,6 +55,19 @@ namespace RTT
         return expected == oro_cmpxchg(addr, expected, value);
     }
 
+    /**
+     * Full memory barrier. Loads and stores before it are not
+     * reordered with loads and stores after it. Use it to publish
+     * or consume data guarded by a plain index or counter.
+     */
+    inline void MemoryFence() {
+#if defined(__GNUC__)
+        __sync_synchronize();
+#elif defined(_MSC_VER)
+        MemoryBarrier();
+#endif
+    }
+
 }}
 
 #endif
@@ -0,0 +1,213 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  CycleStatistics.cpp
+
+                        CycleStatistics.cpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "CycleStatistics.hpp"
+#include "Mutex.hpp"
+#include "MutexLock.hpp"
+#include <algorithm>
+#include <list>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#include <time.h>
+#endif
+
+namespace RTT
+{ namespace os {
+
+    namespace {
+        /**
+         * The list of all CycleStatistics objects. It is never
+         * destroyed, such that objects which are destroyed after
+         * main() returns can still unregister.
+         */
+        struct Registry {
+            Mutex lock;
+            std::list<CycleStatistics*> all;
+        };
+
+        Registry& registry() {
+            static Registry* r = new Registry();
+            return *r;
+        }
+
+        inline unsigned int bucketOf(NANO_TIME ns) {
+            if ( ns <= 1 )
+                return 0;
+#if defined(__GNUC__)
+            unsigned int b = 63 - __builtin_clzll( (unsigned long long)ns );
+#else
+            unsigned int b = 0;
+            for (unsigned long long v = ns; (v >>= 1) != 0; )
+                ++b;
+#endif
+            return b < CycleStatistics::Buckets ? b : CycleStatistics::Buckets - 1;
+        }
+    }
+
+    CycleStatistics::Snapshot::Snapshot()
+        : cycles(0), wall_min(0), wall_max(0), wall_total(0),
+          cpu_min(0), cpu_max(0), cpu_total(0),
+          overruns(0), wakeups(0), jitter_max(0), jitter_total(0)
+    {
+        std::fill(histogram, histogram + Buckets, 0ULL);
+    }
+
+    NANO_TIME CycleStatistics::Snapshot::wallMean() const {
+        return cycles ? wall_total / NANO_TIME(cycles) : 0;
+    }
+
+    NANO_TIME CycleStatistics::Snapshot::cpuMean() const {
+        return cycles ? cpu_total / NANO_TIME(cycles) : 0;
+    }
+
+    NANO_TIME CycleStatistics::Snapshot::jitterMean() const {
+        return wakeups ? jitter_total / NANO_TIME(wakeups) : 0;
+    }
+
+    CycleStatistics::CycleStatistics(const std::string& name)
+        : msequence(0), mreset(0), menabled(true), mcpu_enabled(false),
+          mstart_wall(0), mstart_cpu(-1), mlast_wakeup(0), mjitter(-1), mname(name)
+    {
+        Registry& r = registry();
+        MutexLock lock(r.lock);
+        r.all.push_back(this);
+    }
+
+    CycleStatistics::~CycleStatistics()
+    {
+        Registry& r = registry();
+        MutexLock lock(r.lock);
+        r.all.remove(this);
+    }
+
+    void CycleStatistics::setName(const std::string& name)
+    {
+        MutexLock lock(registry().lock);
+        mname = name;
+    }
+
+    std::string CycleStatistics::getName() const
+    {
+        MutexLock lock(registry().lock);
+        return mname;
+    }
+
+    void CycleStatistics::beginWrite()
+    {
+        msequence = msequence + 1;
+        MemoryFence();
+        if ( mreset ) {
+            mreset = 0;
+            mdata = Snapshot();
+        }
+    }
+
+    void CycleStatistics::record(NANO_TIME wall, NANO_TIME cpu)
+    {
+        beginWrite();
+        if ( mdata.cycles == 0 || wall < mdata.wall_min )
+            mdata.wall_min = wall;
+        if ( wall > mdata.wall_max )
+            mdata.wall_max = wall;
+        mdata.wall_total += wall;
+        if ( cpu >= 0 ) {
+            if ( mdata.cycles == 0 || cpu < mdata.cpu_min )
+                mdata.cpu_min = cpu;
+            if ( cpu > mdata.cpu_max )
+                mdata.cpu_max = cpu;
+            mdata.cpu_total += cpu;
+        }
+        ++mdata.histogram[ bucketOf(wall) ];
+        ++mdata.cycles;
+        if ( mjitter >= 0 ) {
+            if ( mjitter > mdata.jitter_max )
+                mdata.jitter_max = mjitter;
+            mdata.jitter_total += mjitter;
+            ++mdata.wakeups;
+            mjitter = -1;
+        }
+        endWrite();
+    }
+
+    void CycleStatistics::overrun()
+    {
+        beginWrite();
+        ++mdata.overruns;
+        endWrite();
+    }
+
+    CycleStatistics::Snapshot CycleStatistics::snapshot() const
+    {
+        Snapshot copy;
+        unsigned int start;
+        do {
+            start = msequence;
+            if ( start & 1 )
+                continue; // the writer is busy.
+            MemoryFence();
+            copy = mdata;
+            MemoryFence();
+        } while ( (start & 1) || start != msequence );
+        return copy;
+    }
+
+    void CycleStatistics::reset()
+    {
+        mreset = 1;
+    }
+
+    NANO_TIME CycleStatistics::threadCpuTime()
+    {
+#if defined(_POSIX_THREAD_CPUTIME) && (_POSIX_THREAD_CPUTIME >= 0)
+        struct timespec ts;
+        if ( clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0 )
+            return NANO_TIME(ts.tv_sec) * 1000000000LL + NANO_TIME(ts.tv_nsec);
+#endif
+        return 0;
+    }
+
+    std::vector< std::pair<std::string, CycleStatistics::Snapshot> > CycleStatistics::snapshotAll()
+    {
+        std::vector< std::pair<std::string, Snapshot> > result;
+        Registry& r = registry();
+        MutexLock lock(r.lock);
+        for (std::list<CycleStatistics*>::const_iterator it = r.all.begin(); it != r.all.end(); ++it)
+            result.push_back( std::make_pair( (*it)->mname, (*it)->snapshot() ) );
+        return result;
+    }
+}}
@@ -0,0 +1,263 @@
+/***************************************************************************
+  tag: Orocos RTT  Sat Oct 17 12:00:00 CEST 2026  CycleStatistics.hpp
+
+                        CycleStatistics.hpp -  description
+                           -------------------
+    begin                : Sat October 17 2026
+    copyright            : (C) 2026 The Orocos RTT contributors
+
+ ***************************************************************************
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU General Public                   *
+ *   License as published by the Free Software Foundation;                 *
+ *   version 2 of the License.                                             *
+ *                                                                         *
+ *   As a special exception, you may use this file as part of a free       *
+ *   software library without restriction.  Specifically, if other files   *
+ *   instantiate templates or use macros or inline functions from this     *
+ *   file, or you compile this file and link it with other files to        *
+ *   produce an executable, this file does not by itself cause the         *
+ *   resulting executable to be covered by the GNU General Public          *
+ *   License.  This exception does not however invalidate any other        *
+ *   reasons why the executable file might be covered by the GNU General   *
+ *   Public License.                                                       *
+ *                                                                         *
+ *   This library is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU     *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public             *
+ *   License along with this library; if not, write to the Free Software   *
+ *   Foundation, Inc., 59 Temple Place,                                    *
+ *   Suite 330, Boston, MA  02111-1307  USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef ORO_OS_CYCLE_STATISTICS_HPP
+#define ORO_OS_CYCLE_STATISTICS_HPP
+
+#include "fosi.h"
+#include "CAS.hpp"
+#include "../rtt-config.h"
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace RTT
+{ namespace os {
+
+    /**
+     * Collects execution time statistics of a cyclic piece of code,
+     * such as the updateHook() of a component or the step() of a
+     * periodic thread.
+     *
+     * The statistics are written by one thread only, the one executing
+     * the cycles, and may be read from any other thread with snapshot().
+     * The counters are guarded by a sequence counter, such that a writer
+     * never waits and a reader never sees a torn snapshot. Recording
+     * a cycle costs two clock reads and a few additions. The thread
+     * CPU time is only measured when enabled with setCpuTimeEnabled(),
+     * since this requires a system call on most targets.
+     *
+     * Every CycleStatistics object registers itself in a process wide
+     * list, which can be read with snapshotAll().
+     */
+    class RTT_API CycleStatistics
+    {
+    public:
+        /**
+         * The number of buckets of the histogram. Bucket \a i counts the
+         * cycles which took between 2^i and 2^(i+1) nanoseconds, the
+         * last bucket counts all longer cycles.
+         */
+        enum { Buckets = 32 };
+
+        /**
+         * A consistent copy of the statistics. All times are in
+         * nanoseconds.
+         */
+        struct Snapshot
+        {
+            Snapshot();
+            /** Number of recorded cycles. */
+            unsigned long long cycles;
+            NANO_TIME wall_min;
+            NANO_TIME wall_max;
+            NANO_TIME wall_total;
+            /** Zero if CPU time measurement is disabled. */
+            NANO_TIME cpu_min;
+            NANO_TIME cpu_max;
+            NANO_TIME cpu_total;
+            /** Log2 bucketed histogram of the wall clock times. */
+            unsigned long long histogram[Buckets];
+            /** Number of missed periods. */
+            unsigned long long overruns;
+            /** Number of recorded wake ups of a periodic thread. */
+            unsigned long long wakeups;
+            /** Largest deviation of a wake up from its period. */
+            NANO_TIME jitter_max;
+            NANO_TIME jitter_total;
+
+            /** Mean wall clock time of a cycle, zero if no cycles. */
+            NANO_TIME wallMean() const;
+            /** Mean thread CPU time of a cycle, zero if no cycles. */
+            NANO_TIME cpuMean() const;
+            /** Mean deviation of a wake up from its period. */
+            NANO_TIME jitterMean() const;
+        };
+
+        /**
+         * Create and register a statistics object.
+         * @param name The name under which snapshotAll() reports it.
+         */
+        CycleStatistics(const std::string& name = "");
+
+        ~CycleStatistics();
+
+        /**
+         * Change the name under which snapshotAll() reports this object.
+         */
+        void setName(const std::string& name);
+
+        std::string getName() const;
+
+        /**
+         * Enable or disable recording. When disabled, start(),
+         * wakeup() and stop() return immediately. Enabled by default.
+         */
+        void setEnabled(bool enabled) { menabled = enabled; }
+
+        bool isEnabled() const { return menabled; }
+
+        /**
+         * Also measure the CPU time consumed by the executing thread.
+         * Disabled by default.
+         */
+        void setCpuTimeEnabled(bool enabled) { mcpu_enabled = enabled; }
+
+        bool isCpuTimeEnabled() const { return mcpu_enabled; }
+
+        /**
+         * Mark the start of a cycle. Only call this from the thread
+         * executing the cycles.
+         */
+        void start()
+        {
+            if ( !menabled )
+                return;
+            mstart_wall = rtos_get_time_ns();
+            mstart_cpu = mcpu_enabled ? threadCpuTime() : -1;
+        }
+
+        /**
+         * Mark the end of a cycle started with start() and
+         * record its duration.
+         */
+        void stop()
+        {
+            if ( !menabled || mstart_wall == 0 )
+                return;
+            NANO_TIME cpu = mstart_cpu >= 0 ? threadCpuTime() - mstart_cpu : -1;
+            record( rtos_get_time_ns() - mstart_wall, cpu );
+            mstart_wall = 0;
+        }
+
+        /**
+         * Record a cycle of which the durations were measured
+         * by the caller.
+         * @param wall The wall clock time of the cycle.
+         * @param cpu The CPU time of the cycle, or a negative
+         * value if it was not measured.
+         */
+        void record(NANO_TIME wall, NANO_TIME cpu = -1);
+
+        /**
+         * Mark the wake up of a periodic thread, which also starts
+         * a cycle. The jitter is the deviation of the time between two
+         * wake ups from \a period. It is recorded by the next stop().
+         */
+        void wakeup(NANO_TIME period)
+        {
+            if ( !menabled )
+                return;
+            NANO_TIME now = rtos_get_time_ns();
+            if ( mlast_wakeup != 0 ) {
+                mjitter = now - mlast_wakeup - period;
+                if ( mjitter < 0 )
+                    mjitter = -mjitter;
+            }
+            mlast_wakeup = now;
+            mstart_wall = now;
+            mstart_cpu = mcpu_enabled ? threadCpuTime() : -1;
+        }
+
+        /**
+         * Forget the previous wake up, such that the next wakeup()
+         * records no jitter. Call this when a thread becomes periodic.
+         */
+        void restartPeriod() { mlast_wakeup = 0; }
+
+        /**
+         * Record that a periodic thread missed its period.
+         */
+        void overrun();
+
+        /**
+         * Read a consistent copy of the statistics. May be called
+         * from any thread.
+         */
+        Snapshot snapshot() const;
+
+        /**
+         * Clear the statistics. The counters are cleared by the
+         * writing thread when it records its next cycle, so this
+         * can be called from any thread.
+         */
+        void reset();
+
+        /**
+         * Returns the thread CPU time of the calling thread, or
+         * zero if this target does not support it.
+         */
+        static NANO_TIME threadCpuTime();
+
+        /**
+         * Read the statistics of all CycleStatistics objects in
+         * this process.
+         * @return A list of (name, snapshot) pairs.
+         */
+        static std::vector< std::pair<std::string, Snapshot> > snapshotAll();
+
+    private:
+        CycleStatistics(const CycleStatistics&);
+        void operator=(const CycleStatistics&);
+
+        /**
+         * Must be called by the writer before changing mdata.
+         */
+        void beginWrite();
+        void endWrite() { MemoryFence(); msequence = msequence + 1; }
+
+        /**
+         * Odd while the writer is updating mdata.
+         */
+        volatile unsigned int msequence;
+        volatile int mreset;
+        volatile bool menabled;
+        volatile bool mcpu_enabled;
+        NANO_TIME mstart_wall;
+        NANO_TIME mstart_cpu;
+        NANO_TIME mlast_wakeup;
+        /**
+         * The jitter of the last wakeup(), or -1 if none.
+         */
+        NANO_TIME mjitter;
+        Snapshot mdata;
+        std::string mname;
+    };
+
+}}
+
+#endif
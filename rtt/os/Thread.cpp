@@ -126,8 +126,10 @@ namespace RTT {
                             if (task->period != 0) // periodic
                             {
                                 MutexLock lock(task->breaker);
+                                task->mstats.restartPeriod();
                                 while(task->running && !task->prepareForExit )
                                 {
+                                    task->mstats.wakeup(cur_period);
                                     TRY
                                     (
                                         SCOPE_ON
@@ -139,6 +141,7 @@ namespace RTT {
                                         SCOPE_OFF
                                         throw;
                                     )
+                                    task->mstats.stop();
 
                                     // Check changes in period
                                     if ( cur_period != task->period) {
@@ -159,6 +162,7 @@ namespace RTT {
                                     // return non-zero to indicate overrun.
                                     if (rtos_task_wait_period(task->getTask()) != 0)
                                     {
+                                        task->mstats.overrun();
                                         ++overruns;
                                         if (overruns == task->maxOverRun)
                                             break; // break while(task->running)
@@ -242,7 +246,7 @@ namespace RTT {
 #ifdef OROPKG_OS_THREAD_SCOPE
         ,d(NULL)
 #endif
-                    , stopTimeout(0)
+                    , stopTimeout(0), mstats(name)
         {
             this->setup(_priority, cpu_affinity, name);
         }
@@ -44,6 +44,7 @@
 
 #include "ThreadInterface.hpp"
 #include "Mutex.hpp"
+#include "CycleStatistics.hpp"
 
 #include <string>
 
@@ -242,6 +243,13 @@ namespace RTT
 
             virtual void setWaitPeriodPolicy(int p);
 
+            /**
+             * Returns the execution time statistics of the periodic
+             * step() of this thread, including its overruns and the
+             * jitter of its wake ups.
+             */
+            CycleStatistics& getCycleStatistics() { return mstats; }
+
         protected:
             /**
              * Exit and destroy the thread
@@ -355,6 +363,11 @@ namespace RTT
              */
             double stopTimeout;
 
+            /**
+             * Recorded by the periodic loop of this thread.
+             */
+            CycleStatistics mstats;
+
 #ifdef OROPKG_OS_THREAD_SCOPE
             // Pointer to Threadscope device
             dev::DigitalOutInterface * d;
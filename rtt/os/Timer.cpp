@@ -58,68 +58,129 @@ namespace RTT {
         // no implementation for periodic execution.
     }
 
+    bool Timer::heapLess(int a, int b) const
+    {
+        const TimerInfo& ta = mtimers[ mheap[a] ];
+        const TimerInfo& tb = mtimers[ mheap[b] ];
+        // equal expiry times fire in order of timer id.
+        return ta.expires < tb.expires || (ta.expires == tb.expires && mheap[a] < mheap[b]);
+    }
+
+    void Timer::heapSwap(int a, int b)
+    {
+        std::swap( mheap[a], mheap[b] );
+        mtimers[ mheap[a] ].heap_index = a;
+        mtimers[ mheap[b] ].heap_index = b;
+    }
+
+    void Timer::heapUp(int i)
+    {
+        while ( i > 0 ) {
+            int parent = (i - 1) / 2;
+            if ( !heapLess(i, parent) )
+                return;
+            heapSwap(i, parent);
+            i = parent;
+        }
+    }
+
+    void Timer::heapDown(int i)
+    {
+        int n = mheap.size();
+        while (true) {
+            int smallest = i;
+            int left = 2 * i + 1;
+            int right = left + 1;
+            if ( left < n && heapLess(left, smallest) )
+                smallest = left;
+            if ( right < n && heapLess(right, smallest) )
+                smallest = right;
+            if ( smallest == i )
+                return;
+            heapSwap(i, smallest);
+            i = smallest;
+        }
+    }
+
+    bool Timer::heapSchedule(TimerId timer_id, Time expires)
+    {
+        TimerInfo& tim = mtimers[timer_id];
+        tim.expires = expires;
+        if ( tim.heap_index < 0 ) {
+            tim.heap_index = mheap.size();
+            mheap.push_back( timer_id );
+            heapUp( tim.heap_index );
+        } else {
+            heapUp( tim.heap_index );
+            heapDown( tim.heap_index );
+        }
+        return tim.heap_index == 0;
+    }
+
+    void Timer::heapRemove(TimerId timer_id)
+    {
+        TimerInfo& tim = mtimers[timer_id];
+        int i = tim.heap_index;
+        if ( i < 0 )
+            return;
+        int last = mheap.size() - 1;
+        if ( i != last ) {
+            heapSwap(i, last);
+            mheap.pop_back();
+            heapUp(i);
+            heapDown(i);
+        } else
+            mheap.pop_back();
+        tim.heap_index = -1;
+    }
+
     void Timer::loop()
     {
         // This code is executed from mThread's thread
         while (!mdo_quit) {
-            Time wake_up_time;
-            TimerId next_timer_id = 0;
-
-            // Select next timer.
-            int ret = 0;
             {// This scope is for MutexLock.
-                // find wake_up_time
-                // check timers queue.
                 MutexLock locker(mmutex);
-                wake_up_time = std::numeric_limits<Time>::max();
-                for (TimerIds::iterator it = mtimers.begin(); it != mtimers.end(); ++it) {
-                    if ( it->expires != 0 && it->expires < wake_up_time  ) {
-                        wake_up_time = it->expires;
-                        next_timer_id = it - mtimers.begin();
-                    }
-                }
-
-                // Wait
-                if ( wake_up_time == std::numeric_limits<Time>::max() )
-                    ret = mcond.wait( mmutex ); // case of no timers
-                else if ( wake_up_time > rtos_get_time_ns() )
-                    ret = mcond.wait_until( mmutex, wake_up_time ); // case of running timers
-                else
-                    ret = -1; // case of timer overrun.
-            }// MutexLock
 
-            // Timeout handling
-            if (ret == -1) {
-                // a timer expired
-                // expires: reset/reprogram the timer that expired:
-                {
-                    MutexLock locker(mmutex);
-                    // detect corner case for resize:
-                    if ( next_timer_id < int(mtimers.size()) ) {
-                        // now clear or reprogram it.
-                        TimerIds::iterator tim = mtimers.begin() + next_timer_id;
-                        if ( tim->period ) {
-                            // periodic timer
-                            tim->expires += tim->period;
-                        } else {
-                            // aperiodic timer
-                            tim->expires = 0;
-                        }
+                // Wait for the first timer in the heap
+                if ( mheap.empty() )
+                    mcond.wait( mmutex ); // case of no timers
+                else if ( mtimers[ mheap.front() ].expires > rtos_get_time_ns() )
+                    mcond.wait_until( mmutex, mtimers[ mheap.front() ].expires ); // case of running timers
+
+                // Collect all expired timers in one pass and reset/reprogram
+                // them. A periodic timer which is late may be collected more than
+                // once, but never more than mtimers.size() timeouts are
+                // processed per pass.
+                if ( mexpired.capacity() < mtimers.size() )
+                    mexpired.reserve( mtimers.size() );
+                mexpired.clear();
+                Time now = rtos_get_time_ns();
+                while ( !mheap.empty() && mexpired.size() < mtimers.size() ) {
+                    TimerId id = mheap.front();
+                    TimerInfo& tim = mtimers[id];
+                    if ( tim.expires > now )
+                        break;
+                    if ( tim.period ) {
+                        // periodic timer
+                        tim.expires += tim.period;
+                        heapDown(0);
+                    } else {
+                        // aperiodic timer
+                        heapRemove(id);
+                        tim.expires = 0;
                     }
+                    // notify waiting threads
+                    tim.expired.broadcast();
+                    mexpired.push_back(id);
                 }
+            }// MutexLock
 
-                // Second: notify waiting threads
-                {// This scope is for MutexLock.
-                    MutexLock locker(mmutex);
-                    mtimers[next_timer_id].expired.broadcast();
-                }// MutexLock
-
-                // Third: send the timeout signal and allow (within the callback)
-                // to reprogram the timer.
-                // If we would expires call timeout(), the code above would overwrite
-                // user settings.
-                timeout( next_timer_id );
-            }
+            // Send the timeout signals and allow (within the callback)
+            // to reprogram the timer.
+            // If we would expires call timeout(), the code above would overwrite
+            // user settings.
+            for (std::vector<TimerId>::iterator it = mexpired.begin(); it != mexpired.end() && !mdo_quit; ++it)
+                timeout( *it );
         }
     }
 
@@ -138,6 +199,7 @@ namespace RTT {
         : mThread(0), mdo_quit(false)
     {
         mtimers.resize(max_timers);
+        mheap.reserve(max_timers);
         if (scheduler != -1) {
             mThread = new Activity(scheduler, priority, 0.0, this, "Timer");
             mThread->start();
@@ -158,7 +220,10 @@ namespace RTT {
     void Timer::setMaxTimers(TimerId max)
     {
         MutexLock locker(mmutex);
+        for (TimerId i = max; i < int(mtimers.size()); ++i)
+            heapRemove(i);
         mtimers.resize(max, TimerInfo() );
+        mheap.reserve(max);
     }
 
     bool Timer::startTimer(TimerId timer_id, double period)
@@ -171,12 +236,11 @@ namespace RTT {
 
         Time due_time = rtos_get_time_ns() + Seconds_to_nsecs( period );
 
-        {
-            MutexLock locker(mmutex);
-            mtimers[timer_id].expires = due_time;
-            mtimers[timer_id].period = Seconds_to_nsecs( period );
-        }
-        mcond.broadcast();
+        MutexLock locker(mmutex);
+        mtimers[timer_id].period = Seconds_to_nsecs( period );
+        // only wake up the timer thread if its next wake up time changed.
+        if ( heapSchedule(timer_id, due_time) )
+            mcond.broadcast();
         return true;
     }
 
@@ -191,12 +255,10 @@ namespace RTT {
         Time now = rtos_get_time_ns();
         Time due_time = now + Seconds_to_nsecs( wait_time );
 
-        {
-            MutexLock locker(mmutex);
-            mtimers[timer_id].expires  = due_time;
-            mtimers[timer_id].period = 0;
-        }
-        mcond.broadcast();
+        MutexLock locker(mmutex);
+        mtimers[timer_id].period = 0;
+        if ( heapSchedule(timer_id, due_time) )
+            mcond.broadcast();
         return true;
     }
 
@@ -235,6 +297,7 @@ namespace RTT {
             log(Error) << "Invalid timer id" << endlog();
             return false;
         }
+        heapRemove(timer_id);
         mtimers[timer_id].expires = 0;
         mtimers[timer_id].period = 0;
         mtimers[timer_id].expired.broadcast();
@@ -59,6 +59,9 @@ namespace RTT
      * method.
      * The resolution of this class depends completely on the timer
      * resolution of the underlying operating system.
+     * Armed timers are kept in a binary heap, so arming, killing
+     * and expiring a timer costs O(log n) in the number of timers.
+     * All timers that expired at a wake up are processed in one pass.
      *
      * If you do not attach an activity, the Timer will create a thread
      * of its own and start it. That thread will be stopped and cleaned up
@@ -80,11 +83,12 @@ namespace RTT
 
         struct TimerInfo
         {
-            TimerInfo() : expires(0), period(0) {}
+            TimerInfo() : expires(0), period(0), heap_index(-1) {}
             TimerInfo(const TimerInfo& other) { *this = other; }
-            TimerInfo& operator=(const TimerInfo& other) { this->expires = other.expires; this->period = other.period; return *this; }
+            TimerInfo& operator=(const TimerInfo& other) { this->expires = other.expires; this->period = other.period; this->heap_index = other.heap_index; return *this; }
             Time expires; // was .first
             Time period;  // was .second
+            int heap_index; // position in mheap, -1 if not armed.
             Condition expired;
         };
 
@@ -95,8 +99,30 @@ namespace RTT
          */
         typedef std::vector<TimerInfo> TimerIds;
         TimerIds mtimers;
+
+        /**
+         * Binary min-heap of the armed timer ids, ordered on
+         * (expires, id). The front is the next timer to expire.
+         * Each TimerInfo stores its own position in heap_index, such
+         * that re-arming and killing a timer are O(log n).
+         */
+        std::vector<TimerId> mheap;
+
+        /**
+         * The ids of the timers expired in one pass of loop(). Only
+         * used by the timer thread.
+         */
+        std::vector<TimerId> mexpired;
         bool mdo_quit;
 
+        bool heapLess(int a, int b) const;
+        void heapSwap(int a, int b);
+        void heapUp(int i);
+        void heapDown(int i);
+        /** Inserts or moves \a timer_id in the heap. Returns true if it became the first to expire. */
+        bool heapSchedule(TimerId timer_id, Time expires);
+        void heapRemove(TimerId timer_id);
+
         bool initialize();
         void finalize();
         void step();
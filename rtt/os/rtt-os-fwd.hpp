@@ -5,6 +5,7 @@ namespace RTT {
     namespace os {
         class AtomicInt;
         class Condition;
+        class CycleStatistics;
         class MainThread;
         class Mutex;
         class MutexInterface;
@@ -50,7 +50,8 @@ RTT::corba::CConnPolicy toCORBA(RTT::ConnPolicy const& policy)
     RTT::corba::CConnPolicy corba_policy;
     corba_policy.type        = RTT::corba::CConnectionModel(policy.type);
     corba_policy.init        = policy.init;
-    corba_policy.lock_policy = RTT::corba::CLockPolicy(policy.lock_policy);
+    // the remote end may be written by several ORB threads.
+    corba_policy.lock_policy = RTT::corba::CLockPolicy(policy.lock_policy == RTT::ConnPolicy::SPSC ? RTT::ConnPolicy::LOCK_FREE : policy.lock_policy);
     corba_policy.pull        = policy.pull;
     corba_policy.size        = policy.size;
     corba_policy.data_size   = policy.data_size;
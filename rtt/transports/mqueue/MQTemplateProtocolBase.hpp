@@ -72,6 +72,8 @@ namespace RTT
                   if ( !is_sender ) {
                       // the receiver needs a buffer to store his messages in.
                       base::ChannelElementBase::shared_ptr buf = detail::DataSourceTypeInfo<T>::getTypeInfo()->buildDataStorage(policy);
+                      if (!buf)
+                          return base::ChannelElementBase::shared_ptr();
                       mq->setOutput(buf);
                   }
                   return mq;
@@ -30,10 +30,12 @@
 #include <base/Buffer.hpp>
 #include <internal/ListLockFree.hpp>
 #include <base/DataObject.hpp>
+#include <internal/ConnFactory.hpp>
 #include <internal/TsPool.hpp>
 //#include <internal/SortedList.hpp>
 
 #include <os/Thread.hpp>
+#include <os/TimeService.hpp>
 #include <rtt-config.h>
 
 using namespace std;
@@ -73,6 +75,15 @@ public:
 };
 
 
+/**
+ * A plain old data version of Dummy, for DataObjectSeqLock.
+ */
+struct PodDummy {
+    double d1;
+    double d2;
+    double d3;
+};
+
 typedef AtomicQueue<Dummy*> QueueType;
 typedef AtomicMWSRQueue<Dummy*> MWSRQueueType;
 
@@ -125,6 +136,7 @@ public:
     BufferLockFree<Dummy>* lockfree;
     BufferLocked<Dummy>* locked;
     BufferUnSync<Dummy>* unsync;
+    BufferSPSC<Dummy>* spsc;
 
     BufferLockFree<Dummy>* clockfree;
     BufferLocked<Dummy>* clocked;
@@ -147,6 +159,7 @@ public:
         lockfree = new BufferLockFree<Dummy>(QS);
         locked = new BufferLocked<Dummy>(QS);
         unsync = new BufferUnSync<Dummy>(QS);
+        spsc = new BufferSPSC<Dummy>(QS);
 
         // circular variants.
         clockfree = new BufferLockFree<Dummy>(QS,Dummy(), true);
@@ -166,6 +179,7 @@ public:
         delete lockfree;
         delete locked;
         delete unsync;
+        delete spsc;
         delete clockfree;
         delete clocked;
         delete cunsync;
@@ -314,6 +328,20 @@ void BuffersDataFlowTest::testBuf()
     BOOST_CHECK( v[8] == *d );
     //BOOST_CHECK( v[9] == *c );
     BOOST_CHECK( 0 == buffer->Pop(v) );
+
+    // drain to the newest sample at once.
+    BOOST_CHECK( buffer->PopNewestWithoutRelease() == 0 );
+    BOOST_CHECK( buffer->Push( *c ) );
+    BOOST_CHECK( buffer->Push( *c ) );
+    BOOST_CHECK( buffer->Push( *d ) );
+    Dummy* n = buffer->PopNewestWithoutRelease();
+    BOOST_REQUIRE( n );
+    BOOST_CHECK( *n == *d );
+    buffer->Release( n );
+    BOOST_CHECK( buffer->Pop(r) == false );
+    v.assign( sz, *c );
+    BOOST_CHECK( buffer->Push( v ) == (int)sz );
+    BOOST_REQUIRE_EQUAL( sz, buffer->Pop(v) );
     delete d;
     delete c;
 }
@@ -570,6 +598,190 @@ struct LLFGrower : public RunnableInterface
     }
 };
 
+struct BufferPusher : public RunnableInterface
+{
+    volatile bool stop;
+    BufferInterface<Dummy>* mbuf;
+    int count;
+    int pushed;
+    BufferPusher(BufferInterface<Dummy>* b, int c ) : stop(false), mbuf(b), count(c), pushed(0) {}
+    bool initialize() {
+        stop = false; pushed = 0;
+        return true;
+    }
+    void step() {
+        while (stop == false && pushed != count ) {
+            if ( mbuf->Push( Dummy(pushed + 1, pushed + 1, pushed + 1) ) )
+                ++pushed;
+            else
+                this->getThread()->yield();
+        }
+    }
+
+    void finalize() {}
+
+    bool breakLoop() {
+        stop = true;
+        return true;
+    }
+};
+
+struct BufferPopper : public RunnableInterface
+{
+    volatile bool stop;
+    BufferInterface<Dummy>* mbuf;
+    int count;
+    int popped;
+    int reordered;
+    BufferPopper(BufferInterface<Dummy>* b, int c ) : stop(false), mbuf(b), count(c), popped(0), reordered(0) {}
+    bool initialize() {
+        stop = false; popped = 0; reordered = 0;
+        return true;
+    }
+    void step() {
+        Dummy* last = 0;
+        while (stop == false && popped != count ) {
+            Dummy* d = mbuf->PopWithoutRelease();
+            if ( d == 0 ) {
+                this->getThread()->yield();
+                continue;
+            }
+            if ( last )
+                mbuf->Release( last );
+            last = d;
+            ++popped;
+            if ( d->d1 != popped || d->d3 != popped )
+                ++reordered;
+        }
+        if ( last )
+            mbuf->Release( last );
+    }
+
+    void finalize() {}
+
+    bool breakLoop() {
+        stop = true;
+        return true;
+    }
+};
+
+/**
+ * Moves \a count samples from one thread to another through \a buf
+ * and returns the time it took, in seconds.
+ */
+double transfer(BufferInterface<Dummy>* buf, int count, int& reordered)
+{
+    BufferPusher* pusher = new BufferPusher( buf, count );
+    BufferPopper* popper = new BufferPopper( buf, count );
+    double duration;
+    {
+        boost::scoped_ptr<Activity> pthread( new Activity(ORO_SCHED_OTHER, 0, 0, popper, "BufferPopper") );
+        boost::scoped_ptr<Activity> wthread( new Activity(ORO_SCHED_OTHER, 0, 0, pusher, "BufferPusher") );
+        os::TimeService::ticks start = os::TimeService::Instance()->getTicks();
+        pthread->start();
+        wthread->start();
+        while ( popper->popped != count && os::TimeService::Instance()->secondsSince(start) < 10.0 )
+            usleep(1000);
+        duration = os::TimeService::Instance()->secondsSince(start);
+        wthread->stop();
+        pthread->stop();
+    }
+    BOOST_CHECK_EQUAL( pusher->pushed, count );
+    BOOST_CHECK_EQUAL( popper->popped, count );
+    reordered = popper->reordered;
+    delete pusher;
+    delete popper;
+    return duration;
+}
+
+/**
+ * Pushes batches that do not fit in the buffers of capacity 10
+ * and checks which samples are kept and how many are dropped.
+ */
+void checkBatch(BufferInterface<int>* buf, BufferInterface<int>* circ)
+{
+    std::vector<int> v;
+    for (int i = 0; i != 25; ++i)
+        v.push_back(i);
+
+    BOOST_CHECK( buf->Push( 100 ) );
+    BOOST_CHECK_EQUAL( buf->Push( v ), (BufferBase::size_type)9 );
+    BOOST_CHECK_EQUAL( buf->dropped(), (BufferBase::size_type)16 );
+    std::vector<int> r;
+    BOOST_REQUIRE_EQUAL( buf->Pop( r ), (BufferBase::size_type)10 );
+    BOOST_CHECK_EQUAL( r[0], 100 );
+    for (int i = 1; i != 10; ++i)
+        BOOST_CHECK_EQUAL( r[i], i - 1 );
+
+    BOOST_CHECK( circ->Push( 100 ) );
+    BOOST_CHECK( circ->Push( 101 ) );
+    circ->Push( v );
+    BOOST_CHECK_EQUAL( circ->dropped(), (BufferBase::size_type)17 );
+    BOOST_REQUIRE_EQUAL( circ->Pop( r ), (BufferBase::size_type)10 );
+    for (int i = 0; i != 10; ++i)
+        BOOST_CHECK_EQUAL( r[i], i + 15 );
+}
+
+struct SeqLockWriter : public RunnableInterface
+{
+    volatile bool stop;
+    DataObjectInterface<PodDummy>* mdobj;
+    int writes;
+    SeqLockWriter(DataObjectInterface<PodDummy>* d ) : stop(false), mdobj(d), writes(0) {}
+    bool initialize() {
+        stop = false; writes = 0;
+        return true;
+    }
+    void step() {
+        while (stop == false ) {
+            ++writes;
+            PodDummy d = { double(writes), double(writes), double(writes) };
+            mdobj->Set( d );
+        }
+    }
+
+    void finalize() {}
+
+    bool breakLoop() {
+        stop = true;
+        return true;
+    }
+};
+
+struct SeqLockReader : public RunnableInterface
+{
+    volatile bool stop;
+    DataObjectInterface<PodDummy>* mdobj;
+    int reads;
+    int torn;
+    int reversed;
+    SeqLockReader(DataObjectInterface<PodDummy>* d ) : stop(false), mdobj(d), reads(0), torn(0), reversed(0) {}
+    bool initialize() {
+        stop = false; reads = 0; torn = 0; reversed = 0;
+        return true;
+    }
+    void step() {
+        PodDummy d;
+        double last = 0.0;
+        while (stop == false ) {
+            mdobj->Get( d );
+            ++reads;
+            if ( d.d1 != d.d2 || d.d2 != d.d3 )
+                ++torn;
+            if ( d.d1 < last )
+                ++reversed;
+            last = d.d1;
+        }
+    }
+
+    void finalize() {}
+
+    bool breakLoop() {
+        stop = true;
+        return true;
+    }
+};
+
 /**
  * A Worker Reads and writes the queue.
  */
@@ -811,6 +1023,77 @@ BOOST_AUTO_TEST_CASE( testBufUnsync )
     testCirc();
 }
 
+BOOST_AUTO_TEST_CASE( testBufSPSC )
+{
+    buffer = spsc;
+    testBuf();
+
+    // the last popped sample survives until the next pop.
+    Dummy c(2.0, 1.0, 0.0);
+    BOOST_CHECK( spsc->Push( c ) );
+    Dummy* held = spsc->PopWithoutRelease();
+    BOOST_REQUIRE( held );
+    std::vector<Dummy> v( QS, Dummy() );
+    BOOST_CHECK_EQUAL( spsc->Push( v ), (BufferBase::size_type)QS );
+    BOOST_CHECK( spsc->full() );
+    BOOST_CHECK( spsc->Push( Dummy() ) == false );
+    BOOST_CHECK( *held == c );
+    spsc->Release( held );
+    BOOST_CHECK_EQUAL( spsc->Pop( v ), (BufferBase::size_type)QS );
+
+    BufferInterface<Dummy>::shared_ptr built = internal::ConnFactory::buildBuffer<Dummy>( ConnPolicy::buffer(QS, ConnPolicy::SPSC) );
+    BOOST_CHECK( dynamic_cast< BufferSPSC<Dummy>* >( built.get() ) );
+    built = internal::ConnFactory::buildBuffer<Dummy>( ConnPolicy::circularBuffer(QS, ConnPolicy::SPSC) );
+    BOOST_CHECK( dynamic_cast< BufferLockFree<Dummy>* >( built.get() ) );
+
+    int reordered = 0;
+    transfer( spsc, 10000, reordered );
+    BOOST_CHECK_EQUAL( reordered, 0 );
+    BOOST_CHECK( spsc->empty() );
+}
+
+BOOST_AUTO_TEST_CASE( testBufBenchmark )
+{
+    const int count = 20000;
+    int reordered = 0;
+    BufferLockFree<Dummy> blockfree( 64 );
+    BufferLocked<Dummy> blocked( 64 );
+    BufferSPSC<Dummy> bspsc( 64 );
+    double tlockfree = transfer( &blockfree, count, reordered );
+    BOOST_CHECK_EQUAL( reordered, 0 );
+    double tlocked = transfer( &blocked, count, reordered );
+    BOOST_CHECK_EQUAL( reordered, 0 );
+    double tspsc = transfer( &bspsc, count, reordered );
+    BOOST_CHECK_EQUAL( reordered, 0 );
+    BOOST_TEST_MESSAGE( "Transfer of " << count << " samples: BufferLockFree " << tlockfree
+                        << "s, BufferLocked " << tlocked << "s, BufferSPSC " << tspsc << "s" );
+}
+
+BOOST_AUTO_TEST_CASE( testBufBatch )
+{
+    BufferLockFree<int> blockfree( 10 ), cblockfree( 10, 0, true );
+    checkBatch( &blockfree, &cblockfree );
+    BufferLocked<int> blocked( 10 ), cblocked( 10, 0, true );
+    checkBatch( &blocked, &cblocked );
+    BufferUnSync<int> bunsync( 10 ), cbunsync( 10, 0, true );
+    checkBatch( &bunsync, &cbunsync );
+
+    // a batch is queued as far as there is room.
+    internal::AtomicMWSRQueue<int*> queue( 4 );
+    int items[6] = { 1, 2, 3, 4, 5, 6 };
+    int* ptrs[6] = { &items[0], &items[1], &items[2], &items[3], &items[4], &items[5] };
+    BOOST_CHECK( queue.enqueue( ptrs[0] ) );
+    BOOST_CHECK_EQUAL( queue.enqueue( ptrs + 1, 5 ), 3u );
+    BOOST_CHECK( queue.isFull() );
+    BOOST_CHECK_EQUAL( queue.enqueue( ptrs, 1 ), 0u );
+    int* p = 0;
+    for (int i = 0; i != 4; ++i) {
+        BOOST_CHECK( queue.dequeue( p ) );
+        BOOST_CHECK_EQUAL( *p, i + 1 );
+    }
+    BOOST_CHECK( queue.isEmpty() );
+}
+
 BOOST_AUTO_TEST_CASE( testDObjLockFree )
 {
     dataobj = dlockfree;
@@ -829,6 +1112,57 @@ BOOST_AUTO_TEST_CASE( testDObjUnSync )
     testDObj();
 }
 
+BOOST_AUTO_TEST_CASE( testDObjSeqLock )
+{
+    PodDummy c = { 2.0, 1.0, 0.0 };
+    PodDummy d = { 0.0, 1.0, 2.0 };
+    DataObjectSeqLock<PodDummy> dseqlock( c );
+    PodDummy r = dseqlock.Get();
+    BOOST_CHECK_EQUAL( r.d1, c.d1 );
+    BOOST_CHECK_EQUAL( r.d3, c.d3 );
+    for (int i = 0; i != 10; ++i) {
+        dseqlock.Set( c );
+        dseqlock.Set( d );
+    }
+    dseqlock.Get( r );
+    BOOST_CHECK_EQUAL( r.d1, d.d1 );
+    BOOST_CHECK_EQUAL( r.d3, d.d3 );
+
+    // lock free data connections of plain old data use the sequence lock.
+    PodDummy z = { 0.0, 0.0, 0.0 };
+    DataObjectInterface<PodDummy>::shared_ptr dobj = internal::ConnFactory::buildDataObject<PodDummy>( ConnPolicy::data(), z );
+    BOOST_CHECK( dynamic_cast< DataObjectSeqLock<PodDummy>* >( dobj.get() ) );
+    DataObjectInterface<Dummy>::shared_ptr dummyobj = internal::ConnFactory::buildDataObject<Dummy>( ConnPolicy::data() );
+    BOOST_CHECK( dynamic_cast< DataObjectLockFree<Dummy>* >( dummyobj.get() ) );
+
+    // more readers than a DataObjectLockFree supports.
+    SeqLockWriter* writer = new SeqLockWriter( dobj.get() );
+    std::vector<SeqLockReader*> readers;
+    std::vector<Activity*> threads;
+    for (int i = 0; i != 4; ++i) {
+        readers.push_back( new SeqLockReader( dobj.get() ) );
+        threads.push_back( new Activity(ORO_SCHED_OTHER, 0, 0, readers.back(), "SeqLockReader") );
+        threads.back()->start();
+    }
+    boost::scoped_ptr<Activity> wthread( new Activity(ORO_SCHED_OTHER, 0, 0, writer, "SeqLockWriter") );
+    wthread->start();
+    sleep(1);
+    wthread->stop();
+    for (unsigned int i = 0; i != threads.size(); ++i) {
+        threads[i]->stop();
+        BOOST_CHECK( readers[i]->reads > 0 );
+        BOOST_CHECK_EQUAL( readers[i]->torn, 0 );
+        BOOST_CHECK_EQUAL( readers[i]->reversed, 0 );
+        delete threads[i];
+        delete readers[i];
+    }
+    // the last write was never dropped.
+    dobj->Get( r );
+    BOOST_CHECK_EQUAL( r.d1, double(writer->writes) );
+    wthread.reset();
+    delete writer;
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 BOOST_FIXTURE_TEST_SUITE( BuffersMPoolTestSuite, BuffersMPoolTest )
 
@@ -877,6 +1211,36 @@ BOOST_AUTO_TEST_CASE( testMemoryPool )
     BOOST_CHECK_EQUAL( mpool->size(), QS);
 }
 
+BOOST_AUTO_TEST_CASE( testLargeMemoryPool )
+{
+    // more elements than a 16 bit index can address.
+    TsPool<Dummy>::size_type sz = 70000;
+    TsPool<Dummy> lpool( sz );
+    BOOST_REQUIRE_EQUAL( sz, lpool.capacity() );
+    BOOST_CHECK_EQUAL( sz, lpool.size() );
+    std::vector<Dummy*> lpv;
+    Dummy* d;
+    while ( (d = lpool.allocate()) )
+        lpv.push_back( d );
+    BOOST_CHECK_EQUAL( lpv.size(), sz );
+    BOOST_CHECK_EQUAL( lpool.size(), 0 );
+    for (TsPool<Dummy>::size_type i = 0; i != lpv.size(); ++i )
+        BOOST_CHECK( lpool.deallocate( lpv[i] ) );
+    BOOST_CHECK_EQUAL( sz, lpool.size() );
+
+    BufferLockFree<Dummy> lbuffer( sz );
+    BOOST_CHECK_EQUAL( lbuffer.capacity(), sz );
+    std::vector<Dummy> v( sz, Dummy(1.0, 2.0, 3.0) );
+    BOOST_CHECK_EQUAL( lbuffer.Push( v ), sz );
+    BOOST_CHECK( lbuffer.full() );
+    BOOST_CHECK_EQUAL( lbuffer.size(), sz );
+    BOOST_CHECK_EQUAL( lbuffer.Pop( v ), sz );
+    BOOST_CHECK( lbuffer.empty() );
+
+    // invalid sizes are refused when building a connection.
+    BOOST_CHECK( !internal::ConnFactory::buildBuffer<Dummy>( ConnPolicy::buffer(-1) ) );
+}
+
 #if 0
 BOOST_AUTO_TEST_CASE( testSortedList )
 {
@@ -24,10 +24,39 @@
 #include <OperationCaller.hpp>
 #include <Operation.hpp>
 #include <Service.hpp>
+#include <Activity.hpp>
+#include <os/Atomic.hpp>
 
 #include "unit.hpp"
 #include "operations_fixture.hpp"
 
+/**
+ * Calls an OwnThread operation from its own thread.
+ */
+struct ConcurrentCaller
+    : public RunnableInterface
+{
+    OperationCaller<double(double&)> m;
+    double base;
+    int errors;
+    os::AtomicInt done;
+    ConcurrentCaller(OperationsFixture* f, double b)
+        : m("m1r", &OperationsFixture::m1r, f, f->tc->engine(), f->caller->engine(), OwnThread),
+          base(b), errors(0), done(0)
+    {}
+    bool initialize() { return true; }
+    void step() {}
+    void loop() {
+        for (int n = 0; n != 200; ++n) {
+            double a = base + n;
+            if ( m(a) != 2 * (base + n) || a != 2 * (base + n) )
+                ++errors;
+        }
+        done.set(1);
+    }
+    void finalize() {}
+};
+
 /**
  * This test suite tests the RTT::OperationCaller object's LocalOperationCaller implementation.
  */
@@ -88,6 +117,31 @@ BOOST_AUTO_TEST_CASE(testOwnThreadOperationCallerCall)
     BOOST_REQUIRE( tc->inException() );
 }
 
+BOOST_AUTO_TEST_CASE(testOwnThreadOperationCallerConcurrentCall)
+{
+    // each thread is woken up by the completion of its own call.
+    const int count = 8;
+    ConcurrentCaller* callers[count];
+    Activity* acts[count];
+    for (int i = 0; i != count; ++i) {
+        callers[i] = new ConcurrentCaller(this, 1000.0 * i);
+        acts[i] = new Activity(ORO_SCHED_OTHER, os::LowestPriority, 0.0, callers[i], "ConcurrentCaller");
+    }
+    for (int i = 0; i != count; ++i)
+        BOOST_CHECK( acts[i]->start() );
+    for (int i = 0; i != count; ++i) {
+        for (int t = 0; t != 1000 && callers[i]->done.read() == 0; ++t)
+            usleep(10000);
+        BOOST_CHECK( callers[i]->done.read() == 1 );
+        BOOST_CHECK_EQUAL( callers[i]->errors, 0 );
+    }
+    for (int i = 0; i != count; ++i) {
+        acts[i]->stop();
+        delete acts[i];
+        delete callers[i];
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testClientThreadOperationCallerSend)
 {
     // we set the owner engine to zero and our caller engine to be able to send.
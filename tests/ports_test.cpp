@@ -25,6 +25,8 @@
 #include <extras/SequentialActivity.hpp>
 #include <extras/SimulationActivity.hpp>
 #include <extras/SimulationThread.hpp>
+#include <Activity.hpp>
+#include <base/RunnableInterface.hpp>
 
 #include <boost/function_types/function_type.hpp>
 #include <OperationCaller.hpp>
@@ -32,6 +34,8 @@
 #include <rtt-config.h>
 
 #include <memory>
+#include <map>
+#include <boost/scoped_ptr.hpp>
 
 using namespace std;
 using namespace RTT;
@@ -55,6 +59,30 @@ public:
     }
 };
 
+/**
+ * Writes a port in a loop until it is stopped.
+ */
+struct PortWriter : public RunnableInterface
+{
+    volatile bool stop;
+    OutputPort<int>& port;
+    int writes;
+    PortWriter(OutputPort<int>& port) : stop(false), port(port), writes(0) {}
+    bool initialize() { stop = false; return true; }
+    void step() {
+        while (stop == false) {
+            port.write( ++writes );
+        }
+    }
+    void finalize() {}
+    bool breakLoop() { stop = true; return true; }
+};
+
+void countCallback(std::map<PortInterface*, int>& callbacks, PortInterface* port)
+{
+    ++callbacks[port];
+}
+
 /**
  * Fixture.
  */
@@ -267,6 +295,29 @@ BOOST_AUTO_TEST_CASE(testPortSimpleConnections)
         BOOST_CHECK( rp.read(value) );
         BOOST_CHECK_EQUAL(20, value);
         BOOST_CHECK_EQUAL( rp.read(value), OldData );
+
+        wp.write(30);
+        wp.write(40);
+        wp.write(50);
+        BOOST_CHECK_EQUAL( rp.readNewest(value), NewData );
+        BOOST_CHECK_EQUAL(50, value);
+        BOOST_CHECK_EQUAL( rp.read(value), OldData );
+        BOOST_CHECK_EQUAL( rp.readNewest(value), OldData );
+        BOOST_CHECK_EQUAL(50, value);
+
+        std::vector<int> samples;
+        for (int i = 1; i <= 6; ++i)
+            samples.push_back(i * 100);
+        wp.write(samples);
+        std::vector<int> all;
+        BOOST_CHECK_EQUAL( rp.readAll(all), NewData );
+        BOOST_REQUIRE_EQUAL( all.size(), 4u );
+        for (int i = 0; i != 4; ++i)
+            BOOST_CHECK_EQUAL( all[i], (i + 1) * 100 );
+        BOOST_CHECK_EQUAL( rp.readAll(all), OldData );
+        BOOST_CHECK( all.empty() );
+        BOOST_CHECK_EQUAL( rp.read(value), OldData );
+        BOOST_CHECK_EQUAL(400, value);
     }
 
     // Try disconnecting from the reader this time
@@ -456,6 +507,166 @@ BOOST_AUTO_TEST_CASE(testPortThreeWritersOneReader)
     BOOST_CHECK_EQUAL( rp.read(value), NoData );
 }
 
+BOOST_AUTO_TEST_CASE(testPortSharedSamples)
+{
+    OutputPort< std::vector<double> > wp("W");
+    InputPort< std::vector<double> > rp1("R1", ConnPolicy::data());
+    InputPort< std::vector<double> > rp2("R2", ConnPolicy::buffer(4));
+    InputPort< std::vector<double> > rp3("R3", ConnPolicy::data(ConnPolicy::LOCKED));
+
+    wp.shareSamples(true);
+    BOOST_CHECK( wp.sharesSamples() );
+    wp.setDataSample( std::vector<double>(10, 0.0) );
+
+    BOOST_CHECK( wp.createConnection(rp1) );
+    BOOST_CHECK( wp.createConnection(rp2) );
+    BOOST_CHECK( wp.createConnection(rp3) );
+
+    InputPort< std::vector<double> >::sample_ptr s1, s2, s3;
+    BOOST_CHECK_EQUAL( rp1.readShared(s1), NoData );
+
+    wp.write( std::vector<double>(10, 1.0) );
+    wp.write( std::vector<double>(10, 2.0) );
+
+    // all readers see the same sample, it is not copied.
+    BOOST_CHECK_EQUAL( rp1.readShared(s1), NewData );
+    BOOST_CHECK_EQUAL( rp3.readShared(s3), NewData );
+    BOOST_REQUIRE( s1 && s3 );
+    BOOST_CHECK( s1 == s3 );
+    BOOST_CHECK_EQUAL( s1->get().size(), 10u );
+    BOOST_CHECK_EQUAL( s1->get()[0], 2.0 );
+    BOOST_CHECK_EQUAL( rp1.readShared(s1), OldData );
+
+    // the buffer keeps the order.
+    BOOST_CHECK_EQUAL( rp2.readShared(s2), NewData );
+    BOOST_CHECK_EQUAL( s2->get()[0], 1.0 );
+    BOOST_CHECK_EQUAL( rp2.readShared(s2), NewData );
+    BOOST_CHECK( s2 == s1 );
+    BOOST_CHECK_EQUAL( rp2.readShared(s2), OldData );
+
+    // copying reads work as well.
+    std::vector<double> value;
+    wp.write( std::vector<double>(10, 3.0) );
+    BOOST_CHECK_EQUAL( rp1.read(value), NewData );
+    BOOST_CHECK_EQUAL( value.size(), 10u );
+    BOOST_CHECK_EQUAL( value[0], 3.0 );
+    BOOST_CHECK_EQUAL( rp2.read(value), NewData );
+    BOOST_CHECK_EQUAL( value[0], 3.0 );
+    BOOST_CHECK_EQUAL( wp.getLastWrittenValue()[0], 3.0 );
+
+    // the previous sample is still valid while it is referenced.
+    BOOST_CHECK_EQUAL( s1->get()[0], 2.0 );
+
+    // the pool was large enough for all connections.
+    for (int i = 0; i != 20; ++i)
+        wp.write( std::vector<double>(10, i) );
+    BOOST_CHECK_EQUAL( wp.getSharedSamplePool()->misses(), 0 );
+
+    // new connections are initialized with the last written value.
+    InputPort< std::vector<double> > rp4("R4", ConnPolicy::data());
+    ConnPolicy policy = ConnPolicy::data();
+    policy.init = true;
+    BOOST_CHECK( wp.createConnection(rp4, policy) );
+    BOOST_CHECK_EQUAL( rp4.read(value), NewData );
+    BOOST_CHECK_EQUAL( value[0], 19.0 );
+
+    wp.disconnect();
+    BOOST_CHECK( !rp1.connected() );
+    BOOST_CHECK_EQUAL( s1->get()[0], 2.0 );
+}
+
+BOOST_AUTO_TEST_CASE(testPortLoanedSamples)
+{
+    OutputPort< std::vector<double> > wp("W");
+    OutputPort< std::vector<double> > wp2("W2");
+    InputPort< std::vector<double> > rp1("R1", ConnPolicy::buffer(2));
+    InputPort< std::vector<double> > rp2("R2", ConnPolicy::data());
+
+    // only ports that share samples can lend them out.
+    internal::LoanedSample< std::vector<double> > loan = wp.loan();
+    BOOST_CHECK( !loan.valid() );
+    BOOST_CHECK( !wp.commit(loan) );
+
+    wp.shareSamples(true);
+    wp.setDataSample( std::vector<double>(10, 0.0) );
+    BOOST_CHECK( wp.createConnection(rp1) );
+    BOOST_CHECK( wp2.createConnection(rp2) );
+
+    InputPort< std::vector<double> >::sample_ptr s1, s2;
+    BOOST_CHECK_EQUAL( rp1.readLoan(s1), NoData );
+
+    // fill in place and publish.
+    loan = wp.loan();
+    BOOST_REQUIRE( loan.valid() );
+    BOOST_CHECK_EQUAL( loan->size(), 10u );
+    std::fill( loan->begin(), loan->end(), 1.0 );
+    const std::vector<double>* address = &loan.value();
+    BOOST_CHECK( wp.commit(loan) );
+    BOOST_CHECK( !loan.valid() );
+
+    BOOST_CHECK_EQUAL( rp1.readLoan(s1), NewData );
+    BOOST_REQUIRE( s1 );
+    BOOST_CHECK_EQUAL( &s1->get(), address );
+    BOOST_CHECK_EQUAL( s1->get()[9], 1.0 );
+    BOOST_CHECK_EQUAL( rp1.readLoan(s1), OldData );
+    BOOST_CHECK_EQUAL( wp.getLastWrittenValue()[0], 1.0 );
+
+    // connections without shared samples are copied once.
+    BOOST_CHECK_EQUAL( rp2.readLoan(s2), NoData );
+    wp2.write( std::vector<double>(3, 2.0) );
+    BOOST_CHECK_EQUAL( rp2.readLoan(s2), NewData );
+    BOOST_REQUIRE( s2 );
+    BOOST_CHECK_EQUAL( s2->get().size(), 3u );
+    BOOST_CHECK_EQUAL( s2->get()[0], 2.0 );
+
+    // steady state does not miss the pool.
+    for (int i = 0; i != 10; ++i) {
+        loan = wp.loan();
+        (*loan)[0] = i;
+        wp.commit(loan);
+        BOOST_CHECK_EQUAL( rp1.readLoan(s1), NewData );
+        BOOST_CHECK_EQUAL( s1->get()[0], i );
+    }
+    BOOST_CHECK_EQUAL( wp.getSharedSamplePool()->misses(), 0 );
+
+    // an uncommitted loan returns to the pool.
+    loan = wp.loan();
+    loan = internal::LoanedSample< std::vector<double> >();
+    BOOST_CHECK_EQUAL( rp1.readLoan(s1, false), OldData );
+}
+
+BOOST_AUTO_TEST_CASE(testPortConnectWhileWriting)
+{
+    OutputPort<int> wp("W");
+    InputPort<int> rp1("R1", ConnPolicy::data());
+    InputPort<int> rp2("R2", ConnPolicy::buffer(10));
+
+    PortWriter* writer = new PortWriter(wp);
+    {
+        boost::scoped_ptr<Activity> athread( new Activity(ORO_SCHED_OTHER, 0, 0, writer, "PortWriter") );
+        BOOST_CHECK( athread->start() );
+
+        // connection changes must not disturb the writer.
+        int value = 0;
+        for (int i = 0; i != 200; ++i) {
+            BOOST_CHECK( wp.createConnection(rp1) );
+            BOOST_CHECK( wp.createConnection(rp2) );
+            BOOST_CHECK( wp.connected() );
+            rp2.disconnect();
+            rp1.read(value);
+            wp.disconnect(&rp1);
+        }
+        BOOST_CHECK( !wp.connected() );
+
+        BOOST_CHECK( wp.createConnection(rp1) );
+        while ( rp1.read(value) != NewData ) {}
+        BOOST_CHECK( value > 0 );
+        BOOST_CHECK( athread->stop() );
+    }
+    BOOST_CHECK( writer->writes > 0 );
+    delete writer;
+}
+
 BOOST_AUTO_TEST_CASE( testPortObjects)
 {
     OutputPort<double> wp1("Write");
@@ -634,6 +845,81 @@ BOOST_AUTO_TEST_CASE(testEventPortSignalling)
     tce->ports()->removePort( rp1.getName() );
 }
 
+BOOST_AUTO_TEST_CASE(testEventPortCoalescing)
+{
+    OutputPort<int> wp1("Write");
+    InputPort<int>  rp1("Read");
+
+    BOOST_CHECK( tce->setTriggerCoalescing(0.5, 4) );
+    tce->start();
+    BOOST_CHECK( !tce->setTriggerCoalescing(0.0) );
+    tce->addEventPort(rp1);
+    wp1.createConnection(rp1, ConnPolicy::buffer(10));
+    tce->resetStats();
+
+    // the first sample triggers at once, the next ones wait for
+    // the interval to end or for 4 pending samples.
+    wp1.write(1);
+    BOOST_CHECK_EQUAL( tce->nb_events, 1 );
+    wp1.write(2);
+    wp1.write(3);
+    wp1.write(4);
+    BOOST_CHECK_EQUAL( tce->nb_events, 1 );
+    wp1.write(5);
+    BOOST_CHECK_EQUAL( tce->nb_events, 2 );
+    BOOST_CHECK_EQUAL( tce->getSuppressedTriggerCount(), 3u );
+
+    // a suppressed trigger is caught up when the interval ends.
+    wp1.write(6);
+    BOOST_CHECK_EQUAL( tce->nb_events, 2 );
+    usleep(800000);
+    BOOST_CHECK_EQUAL( tce->nb_events, 3 );
+    BOOST_CHECK_EQUAL( tce->getPortTriggerCount(), 3u );
+    BOOST_CHECK_EQUAL( tce->getSuppressedTriggerCount(), 4u );
+
+    tce->stop();
+    BOOST_CHECK( tce->setTriggerCoalescing(0.0) );
+    BOOST_CHECK_EQUAL( tce->getSuppressedTriggerCount(), 0u );
+    tce->ports()->removePort( rp1.getName() );
+}
+
+BOOST_AUTO_TEST_CASE(testEventPortDeduplication)
+{
+    EventPortsTC slave;
+    slave.setActivity( new SlaveActivity() );
+    OutputPort<int> wp1("Write1"), wp2("Write2");
+    InputPort<int>  rp1("Read1"), rp2("Read2"), rp3("Read3");
+    std::map<PortInterface*, int> callbacks;
+    slave.addEventPort(rp1, boost::bind(&countCallback, boost::ref(callbacks), _1) );
+    slave.addEventPort(rp2, boost::bind(&countCallback, boost::ref(callbacks), _1) );
+    slave.addEventPort(rp3, boost::bind(&countCallback, boost::ref(callbacks), _1) );
+    wp1.createConnection(rp1, ConnPolicy::buffer(100));
+    wp2.createConnection(rp2, ConnPolicy::data());
+    slave.start();
+
+    // many samples on a port run its callback only once.
+    for (int i = 0; i != 80; ++i)
+        wp1.write(i);
+    wp2.write(1);
+    BOOST_CHECK( slave.update() );
+    BOOST_CHECK_EQUAL( callbacks[&rp1], 1 );
+    BOOST_CHECK_EQUAL( callbacks[&rp2], 1 );
+    BOOST_CHECK_EQUAL( callbacks[&rp3], 0 );
+    BOOST_CHECK( slave.update() );
+    BOOST_CHECK_EQUAL( callbacks[&rp1], 1 );
+
+    wp1.write(100);
+    slave.ports()->removePort( rp2.getName() );
+    wp2.write(2);
+    BOOST_CHECK( slave.update() );
+    BOOST_CHECK_EQUAL( callbacks[&rp1], 2 );
+    BOOST_CHECK_EQUAL( callbacks[&rp2], 1 );
+
+    slave.stop();
+    slave.ports()->removePort( rp1.getName() );
+    slave.ports()->removePort( rp3.getName() );
+}
+
 BOOST_AUTO_TEST_CASE(testPlainPortNotSignalling)
 {
     OutputPort<double> wp1("Write");
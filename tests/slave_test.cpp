@@ -24,7 +24,10 @@
 #include <rtt/TaskContext.hpp>
 #include <rtt/Operation.hpp>
 #include <rtt/OperationCaller.hpp>
+#include <rtt/InputPort.hpp>
+#include <rtt/OutputPort.hpp>
 #include <rtt/extras/SlaveActivity.hpp>
+#include <rtt/extras/DataFlowActivity.hpp>
 
 #include <rtt/os/Mutex.hpp>
 #include <rtt/os/Condition.hpp>
@@ -115,6 +118,36 @@ public:
     RTT::OperationCaller<void()> slave_operation_caller;
 };
 
+/**
+ * Writes one more than it read, or a counter if it has no input.
+ */
+class StageComponent : public TaskContext
+{
+public:
+    StageComponent(const std::string& name, bool source = false)
+      : TaskContext(name), value(0), source(source)
+    {
+        this->ports()->addPort("in", in);
+        this->ports()->addPort("out", out);
+    }
+
+    void updateHook()
+    {
+        int v;
+        if ( source )
+            ++value;
+        else if ( in.read(v) == NewData )
+            value = v + 1;
+        out.write(value);
+    }
+
+public:
+    RTT::InputPort<int> in;
+    RTT::OutputPort<int> out;
+    int value;
+    bool source;
+};
+
 /**
  * Tests operation calls and functions of components running in a SlaveActivity
  */
@@ -180,4 +213,50 @@ BOOST_AUTO_TEST_CASE( testSlaveOperationCallWithCallback )
     BOOST_CHECK_EQUAL( client.callback_operation_called_counter, 1 );
 }
 
+// Test the execution order of a DataFlowActivity
+BOOST_AUTO_TEST_CASE( testDataFlowActivity )
+{
+    StageComponent sensor("sensor", true), filter("filter"), actuator("actuator");
+    BOOST_CHECK( sensor.out.connectTo( &filter.in ) );
+    BOOST_CHECK( filter.out.connectTo( &actuator.in ) );
+
+    RTT::extras::DataFlowActivity act(ORO_SCHED_OTHER, RTT::os::LowestPriority, 0.0);
+    BOOST_CHECK( !act.addComponent( &actuator ) );
+    BOOST_REQUIRE( act.start() );
+    BOOST_CHECK( act.addComponent( &actuator ) );
+    BOOST_CHECK( act.addComponent( &filter ) );
+    BOOST_CHECK( act.addComponent( &sensor ) );
+    BOOST_CHECK( !act.addComponent( &sensor ) );
+
+    std::vector<TaskContext*> order = act.getSchedule();
+    BOOST_REQUIRE_EQUAL( order.size(), 3u );
+    BOOST_CHECK( order[0] == &sensor );
+    BOOST_CHECK( order[1] == &filter );
+    BOOST_CHECK( order[2] == &actuator );
+    BOOST_CHECK( act.getCyclicComponents().empty() );
+
+    // a sample reaches the actuator in the step in which it was produced.
+    BOOST_CHECK( sensor.start() && filter.start() && actuator.start() );
+    BOOST_CHECK( act.trigger() );
+    usleep(100000);
+    BOOST_CHECK( act.trigger() );
+    usleep(100000);
+    BOOST_CHECK( sensor.value >= 2 );
+    BOOST_CHECK_EQUAL( actuator.value, sensor.value + 2 );
+
+    // cycles are reported.
+    BOOST_CHECK( actuator.out.connectTo( &sensor.in ) );
+    BOOST_CHECK( !act.updateSchedule() );
+    BOOST_CHECK_EQUAL( act.getCyclicComponents().size(), 3u );
+    BOOST_CHECK_EQUAL( act.getSchedule().size(), 3u );
+
+    BOOST_CHECK( !act.removeComponent( &sensor ) );
+    BOOST_CHECK( sensor.stop() && filter.stop() && actuator.stop() );
+    BOOST_CHECK( act.removeComponent( &sensor ) );
+    BOOST_CHECK( act.removeComponent( &filter ) );
+    BOOST_CHECK( act.removeComponent( &actuator ) );
+    BOOST_CHECK( act.getSchedule().empty() );
+    BOOST_CHECK( act.stop() );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
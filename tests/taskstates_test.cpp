@@ -26,6 +26,8 @@
 #include <extras/SimulationActivity.hpp>
 #include <extras/SimulationThread.hpp>
 #include <os/fosi.h>
+#include <os/Atomic.hpp>
+#include <os/CAS.hpp>
 
 #include <boost/function_types/function_type.hpp>
 #include <OperationCaller.hpp>
@@ -170,9 +172,55 @@ public:
     int  updatecount;
 };
 
+/**
+ * Counts how many children execute their updateHook() at the same time.
+ */
+struct ParallelCounter
+{
+    os::AtomicInt inside, updates;
+    volatile int max_inside;
+    ParallelCounter() : inside(0), updates(0), max_inside(0) {}
+};
+
+class ParallelChild
+    : public TaskCore
+{
+public:
+    ParallelChild(ExecutionEngine* parent, ParallelCounter& c, bool dothrow = false)
+        : TaskCore(parent), counter(c), dothrow(dothrow)
+    {}
+
+    void updateHook() {
+        counter.inside.inc();
+        int now = counter.inside.read(), max;
+        do {
+            max = counter.max_inside;
+        } while ( now > max && !os::CAS(&counter.max_inside, max, now) );
+        usleep(50000);
+        counter.updates.inc();
+        counter.inside.dec();
+        if ( dothrow )
+            throw A();
+    }
+
+    ParallelCounter& counter;
+    bool dothrow;
+};
+
 /**
  * Fixture.
  */
+struct CountingFunction
+    : public base::ExecutableInterface
+{
+    int runs, max;
+    CountingFunction() : runs(0), max(-1) {}
+    bool execute() {
+        ++runs;
+        return max < 0 || runs < max;
+    }
+};
+
 class TaskStates_Test
 {
 public:
@@ -638,6 +686,113 @@ BOOST_AUTO_TEST_CASE( testExecutionEngine)
     tsim->run(0);
 }
 
+BOOST_AUTO_TEST_CASE( testExecutionEngineFunctions )
+{
+    // more functions than the size of the pending queue.
+    const int count = 250;
+    CountingFunction funcs[count];
+    ExecutionEngine ee(0);
+    BOOST_CHECK( tsim->stop() );
+    BOOST_CHECK( tsim->run(&ee) );
+    BOOST_CHECK( tsim->start() );
+
+    funcs[0].max = 3;
+    for (int i = 0; i != count; ++i) {
+        BOOST_CHECK( ee.runFunction( &funcs[i] ) );
+        if ( i % 50 == 49 )
+            BOOST_CHECK( SimulationThread::Instance()->run(1) );
+    }
+    BOOST_CHECK( SimulationThread::Instance()->run(5) );
+    // the first one finished after 3 runs.
+    BOOST_CHECK_EQUAL( funcs[0].runs, 3 );
+    BOOST_CHECK( !funcs[0].isLoaded() );
+    BOOST_CHECK_EQUAL( funcs[1].runs, 10 );
+    BOOST_CHECK_EQUAL( funcs[count-1].runs, 6 );
+    for (int i = 1; i != count; ++i)
+        BOOST_CHECK( funcs[i].isLoaded() );
+
+    // remove from the middle and the ends.
+    BOOST_CHECK( tsim->stop() );
+    BOOST_CHECK( ee.removeFunction( &funcs[1] ) );
+    BOOST_CHECK( ee.removeFunction( &funcs[100] ) );
+    BOOST_CHECK( ee.removeFunction( &funcs[count-1] ) );
+    BOOST_CHECK( !funcs[100].isLoaded() );
+    BOOST_CHECK( tsim->start() );
+    BOOST_CHECK( SimulationThread::Instance()->run(1) );
+    BOOST_CHECK_EQUAL( funcs[1].runs, 10 );
+    BOOST_CHECK_EQUAL( funcs[2].runs, 11 );
+    BOOST_CHECK_EQUAL( funcs[100].runs, 8 );
+    BOOST_CHECK_EQUAL( funcs[101].runs, 9 );
+    BOOST_CHECK_EQUAL( funcs[count-1].runs, 6 );
+    BOOST_CHECK( tsim->stop() );
+    tsim->run(0);
+    // the engine unloads the remaining functions when destroyed.
+}
+
+BOOST_AUTO_TEST_CASE( testParallelChildren )
+{
+    TaskContext parent("parent");
+    parent.engine()->setParallelChildren(2);
+    BOOST_CHECK_EQUAL( parent.engine()->getParallelChildren(), 2u );
+
+    ParallelCounter counter;
+    {
+        ParallelChild c1( parent.engine(), counter ), c2( parent.engine(), counter ),
+            c3( parent.engine(), counter ), c4( parent.engine(), counter, true );
+        BOOST_CHECK( c1.start() && c2.start() && c3.start() && c4.start() );
+        usleep(500000);
+        BOOST_CHECK( counter.updates.read() >= 4 );
+        BOOST_CHECK( counter.max_inside >= 2 );
+        // the exception of a child executed by a worker is handled.
+        BOOST_CHECK( c4.inException() );
+        BOOST_CHECK( c1.isRunning() && c2.isRunning() && c3.isRunning() );
+
+        // back to sequential execution.
+        parent.engine()->setParallelChildren(0);
+        BOOST_CHECK( c1.trigger() );
+        usleep(300000);
+        counter.max_inside = 0;
+        int updates = counter.updates.read();
+        BOOST_CHECK( c1.trigger() );
+        usleep(300000);
+        BOOST_CHECK( counter.updates.read() > updates );
+        BOOST_CHECK_EQUAL( counter.max_inside, 1 );
+        BOOST_CHECK( c1.stop() && c2.stop() && c3.stop() );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( testCycleStatistics )
+{
+    BOOST_CHECK( tc->start() );
+    BOOST_CHECK( SimulationThread::Instance()->run(10) );
+    os::CycleStatistics::Snapshot s = tc->getCycleStatistics().snapshot();
+    BOOST_CHECK_EQUAL( s.cycles, 10u );
+    BOOST_CHECK( s.wall_min <= s.wall_max );
+    BOOST_CHECK( s.wallMean() <= s.wall_max );
+    unsigned long long total = 0;
+    for (int i = 0; i != os::CycleStatistics::Buckets; ++i)
+        total += s.histogram[i];
+    BOOST_CHECK_EQUAL( total, s.cycles );
+
+    // the statistics service.
+    BOOST_REQUIRE( tc->provides()->hasService("statistics") );
+    OperationCaller<unsigned int(void)> count = tc->provides("statistics")->getOperation("getCycleCount");
+    OperationCaller<void(void)> reset = tc->provides("statistics")->getOperation("reset");
+    BOOST_CHECK_EQUAL( count(), 10u );
+    reset();
+    BOOST_CHECK( SimulationThread::Instance()->run(2) );
+    BOOST_CHECK_EQUAL( count(), 2u );
+
+    // the global snapshot.
+    std::vector< std::pair<std::string, os::CycleStatistics::Snapshot> > all = os::CycleStatistics::snapshotAll();
+    bool found = false;
+    for (unsigned int i = 0; i != all.size(); ++i)
+        if ( all[i].first == "root" && all[i].second.cycles == 2 )
+            found = true;
+    BOOST_CHECK( found );
+    BOOST_CHECK( tc->stop() );
+}
+
 class calling_error_does_not_override_a_stop_transition_Task : public RTT::TaskContext
 {
 public:
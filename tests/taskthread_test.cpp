@@ -133,6 +133,51 @@ struct TestRunner
 };
 
 
+/**
+ * Counts its executions and checks that they never overlap.
+ */
+struct PoolRunner
+    : public RunnableInterface
+{
+    os::AtomicInt loops, inside;
+    bool overlapped, self;
+    PoolRunner() : loops(0), inside(0), overlapped(false), self(true) {}
+
+    bool initialize() { return true; }
+    void step() {}
+    void loop() {
+        inside.inc();
+        if ( inside.read() != 1 )
+            overlapped = true;
+        if ( !getActivity()->thread()->isSelf() )
+            self = false;
+        usleep(100);
+        loops.inc();
+        inside.dec();
+    }
+    void finalize() {}
+};
+
+struct GroupRunner
+    : public RunnableInterface
+{
+    os::AtomicInt loops;
+    NANO_TIME first, last;
+    useconds_t delay;
+    GroupRunner(useconds_t d = 0) : loops(0), first(0), last(0), delay(d) {}
+
+    bool initialize() { return true; }
+    void step() {
+        last = rtos_get_time_ns();
+        if ( first == 0 )
+            first = last;
+        if ( delay )
+            usleep(delay);
+        loops.inc();
+    }
+    void finalize() {}
+};
+
 void
 ActivitiesThreadTest::setUp()
 {
@@ -414,6 +459,116 @@ BOOST_AUTO_TEST_CASE( testSequential )
     BOOST_CHECK( mtask.start() == false );
 }
 
+BOOST_AUTO_TEST_CASE( testThreadPool )
+{
+    ThreadPool::shared_ptr pool( new ThreadPool(3, ORO_SCHED_OTHER, os::LowestPriority, ~0, 8, "TestPool") );
+    BOOST_CHECK_EQUAL( pool->getWorkerCount(), 3u );
+
+    const int count = 8;
+    PoolRunner runners[count];
+    ThreadPoolActivity* acts[count];
+    for (int i = 0; i != count; ++i)
+        acts[i] = new ThreadPoolActivity( pool, &runners[i] );
+    // the pool is full.
+    ThreadPoolActivity extra( pool );
+    BOOST_CHECK( !extra.start() );
+
+    BOOST_CHECK( !acts[0]->thread()->isSelf() );
+    BOOST_CHECK( !acts[0]->trigger() );
+    for (int i = 0; i != count; ++i) {
+        BOOST_CHECK( acts[i]->start() );
+        BOOST_CHECK( acts[i]->isActive() );
+        BOOST_CHECK( !acts[i]->isPeriodic() );
+    }
+    for (int n = 0; n != 200; ++n)
+        for (int i = 0; i != count; ++i)
+            BOOST_CHECK( acts[i]->trigger() );
+    usleep(500000);
+    // triggers are merged, but the last one is never lost.
+    int loops[count];
+    for (int i = 0; i != count; ++i) {
+        loops[i] = runners[i].loops.read();
+        BOOST_CHECK( loops[i] >= 1 );
+        BOOST_CHECK( loops[i] <= 201 );
+        BOOST_CHECK( acts[i]->trigger() );
+    }
+    usleep(500000);
+    for (int i = 0; i != count; ++i) {
+        BOOST_CHECK( acts[i]->stop() );
+        BOOST_CHECK( !acts[i]->isRunning() );
+        BOOST_CHECK_EQUAL( runners[i].loops.read(), loops[i] + 1 );
+        BOOST_CHECK( !runners[i].overlapped );
+        BOOST_CHECK( runners[i].self );
+        delete acts[i];
+    }
+}
+
+BOOST_AUTO_TEST_CASE( testActivityGroup )
+{
+    // two members released half a period apart.
+    ActivityGroup group(0.02);
+    GroupRunner r1, r2;
+    GroupActivity a1(&group, 0.0, ORO_SCHED_OTHER, os::LowestPriority, ~0, &r1, "Member1");
+    GroupActivity a2(&group, 0.01, ORO_SCHED_OTHER, os::LowestPriority, ~0, &r2, "Member2");
+    BOOST_CHECK( a1.isPeriodic() );
+    BOOST_CHECK_EQUAL( a1.getPeriod(), 0.02 );
+    BOOST_CHECK( !a1.setPeriod(0.1) );
+    BOOST_CHECK( !a1.trigger() );
+    BOOST_CHECK( a1.start() );
+    BOOST_CHECK( a2.start() );
+    BOOST_CHECK_EQUAL( group.getMemberCount(), 2u );
+    usleep(260000);
+    BOOST_CHECK( a1.stop() );
+    BOOST_CHECK( a2.stop() );
+    BOOST_CHECK_EQUAL( group.getMemberCount(), 0u );
+    BOOST_CHECK( r1.loops.read() >= 10 && r1.loops.read() <= 16 );
+    BOOST_CHECK( r2.loops.read() >= 10 && r2.loops.read() <= 16 );
+    NANO_TIME offset = r2.first - r1.first;
+    BOOST_CHECK_MESSAGE( offset > 5000000 && offset < 15000000, "phase offset was " << offset << "ns" );
+
+    // a barrier holds the fast member back to the pace of the slow one.
+    ActivityGroup barrier(0.01, true);
+    BOOST_CHECK( barrier.hasBarrier() );
+    GroupRunner slow(30000), fast;
+    GroupActivity s(&barrier, 0.0, ORO_SCHED_OTHER, os::LowestPriority, ~0, &slow, "Slow");
+    GroupActivity f(&barrier, 0.0, ORO_SCHED_OTHER, os::LowestPriority, ~0, &fast, "Fast");
+    BOOST_CHECK( s.start() );
+    BOOST_CHECK( f.start() );
+    usleep(300000);
+    BOOST_CHECK( f.stop() );
+    BOOST_CHECK( s.stop() );
+    BOOST_CHECK( slow.loops.read() >= 3 );
+    BOOST_CHECK( abs( slow.loops.read() - fast.loops.read() ) <= 1 );
+    BOOST_CHECK( barrier.getOverrunCount() > 0 );
+}
+
+BOOST_AUTO_TEST_CASE( testCycleStatistics )
+{
+    PoolRunner runner;
+    Activity act(3, 0.01, &runner, "StatsThread");
+    BOOST_CHECK( act.start() );
+    usleep(200000);
+    BOOST_CHECK( act.stop() );
+    os::CycleStatistics::Snapshot s = act.getCycleStatistics().snapshot();
+    BOOST_CHECK( s.cycles >= 5 );
+    BOOST_CHECK( s.wakeups >= 4 );
+    BOOST_CHECK( s.wakeups < s.cycles );
+    BOOST_CHECK( s.jitter_max >= s.jitterMean() );
+
+    // measure the recording overhead of one cycle.
+    os::CycleStatistics stats("Overhead");
+    const int cycles = 100000;
+    NANO_TIME start = rtos_get_time_ns();
+    for (int i = 0; i != cycles; ++i) {
+        stats.start();
+        stats.stop();
+    }
+    NANO_TIME overhead = (rtos_get_time_ns() - start) / cycles;
+    BOOST_TEST_MESSAGE( "CycleStatistics overhead per cycle: " << overhead << "ns" );
+    BOOST_CHECK_EQUAL( stats.snapshot().cycles, (unsigned long long)cycles );
+    BOOST_CHECK( overhead < 1000 );
+}
+
 BOOST_AUTO_TEST_CASE( testScheduler )
 {
     int rtsched = ORO_SCHED_OTHER;
@@ -21,6 +21,7 @@
 #include "time_test.hpp"
 #include <boost/bind.hpp>
 #include <os/Timer.hpp>
+#include <os/Atomic.hpp>
 #include <rtt-detail-fwd.hpp>
 #include <iostream>
 
@@ -86,6 +87,21 @@ struct TestTimer
     }
 };
 
+struct CountingTimer
+    : public Timer
+{
+    os::AtomicInt count;
+    nsecs last;
+    CountingTimer(TimerId max_timers, int scheduler = -1)
+        : Timer(max_timers, scheduler, os::HighestPriority), count(0), last(0)
+    {}
+    void timeout(Timer::TimerId id)
+    {
+        last = rtos_get_time_ns();
+        count.inc();
+    }
+};
+
 BOOST_FIXTURE_TEST_SUITE( TimeTestSuite, TimeTest )
 
 BOOST_AUTO_TEST_CASE( testSecondsConversion )
@@ -350,4 +366,42 @@ BOOST_AUTO_TEST_CASE( testTimerWaitFor )
     BOOST_REQUIRE_CLOSE( hbg->secondsSince(0), now + 0.5, 0.1 );
 }
 
+BOOST_AUTO_TEST_CASE( testTimerScaling )
+{
+    for (int n = 10; n <= 100000; n *= 10) {
+        // arm, re-arm and kill cost without a timer thread.
+        CountingTimer idle(n);
+        nsecs start = rtos_get_time_ns();
+        for (int i = 0; i != n; ++i)
+            BOOST_REQUIRE( idle.arm(i, 10.0 + 0.001 * ((i * 7919) % n)) );
+        nsecs arm = (rtos_get_time_ns() - start) / n;
+        start = rtos_get_time_ns();
+        for (int i = 0; i != n; ++i)
+            idle.arm(i, 20.0 + 0.001 * ((i * 104729) % n)); // watchdog kick
+        nsecs rearm = (rtos_get_time_ns() - start) / n;
+        start = rtos_get_time_ns();
+        for (int i = 0; i != n; ++i)
+            idle.killTimer(i);
+        nsecs kill = (rtos_get_time_ns() - start) / n;
+        BOOST_CHECK( !idle.isArmed(0) && !idle.isArmed(n - 1) );
+
+        // expiry throughput of the timer thread: all timers expire within
+        // the time it took to arm them, the lag is the time the timer thread
+        // needs to catch up with the last deadline.
+        CountingTimer timer(n, ORO_SCHED_OTHER);
+        for (int i = 0; i != n; ++i)
+            timer.arm(i, 0.2);
+        nsecs last_deadline = rtos_get_time_ns() + Seconds_to_nsecs(0.2);
+        nsecs deadline = last_deadline + Seconds_to_nsecs(10.0);
+        while ( timer.count.read() != n && rtos_get_time_ns() < deadline )
+            usleep(1000);
+        BOOST_CHECK_EQUAL( timer.count.read(), n );
+        nsecs lag = timer.last - last_deadline;
+
+        BOOST_TEST_MESSAGE( "Timer with " << n << " timers: arm " << arm << "ns, re-arm " << rearm
+                            << "ns, kill " << kill << "ns, lag after last expiry " << lag / 1000 << "us" );
+        BOOST_CHECK( rearm < 100000 );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()